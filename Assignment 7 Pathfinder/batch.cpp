@@ -0,0 +1,201 @@
+/*
+ * File: batch.cpp
+ * ---------------
+ * This file implements the batch mode: reading the query file, running the queries on the worker threads and
+ * writing the report.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include "batch.h"
+#include "parallel.h"
+#include "deltastepping.h"
+#include "parallelmst.h"
+
+/*
+ * Type: batchQueryT
+ * -----------------
+ * One line of the query file and, once it has run, its result.
+ */
+struct batchQueryT{
+	string startName, endName;
+	nodeT *start, *end;    // NULL if the name is not in the graph
+	bool found;
+	int distance;
+	searchStatsT stats;    // counters and time of RunQuery
+	Stack<arcT *> path;
+};
+
+bool ParseBatchSettings(string text, batchSettingsT &settings){
+	istringstream in(text);
+	in >> settings.graphFile >> settings.queryFile >> settings.outputFile;
+	if(in.fail()) return false;
+	settings.numThreads = DefaultThreadCount();
+	settings.mode = DIJKSTRA_SEARCH;
+	settings.statsFile = "";
+	int value;
+	if(in >> value){
+		if(value < 1) return false;
+		settings.numThreads = value;
+		if(in >> value){
+			if(value < 1 || value > CACHED_TREE_SEARCH + 1) return false;
+			settings.mode = searchModeT(value - 1);
+			in >> settings.statsFile;
+		}
+	}
+	return in.eof();
+}
+
+/* Reads the graph without drawing it */
+static bool LoadBatchGraph(string filename, graphT &graph){
+	ifstream in(filename.c_str());
+	if(in.fail()) return false;
+	string imageName;
+	getline(in, imageName);
+	FreeGraph(graph);
+	graph.fileName = filename;
+	ReadGraph(in, graph);
+	CalibrateHeuristic(graph);
+	return true;
+}
+
+/* Reads the start and end names of every non blank line and looks up their nodes */
+static bool ReadQueries(string filename, graphT &graph, Vector<batchQueryT> &queries){
+	ifstream in(filename.c_str());
+	if(in.fail()) return false;
+	string line;
+	while(getline(in, line)){
+		istringstream fields(line);
+		batchQueryT query;
+		if(!(fields >> query.startName >> query.endName)) continue;
+		query.start = graph.nodes.containsKey(query.startName) ? graph.nodes.getValue(query.startName) : NULL;
+		query.end = graph.nodes.containsKey(query.endName) ? graph.nodes.getValue(query.endName) : NULL;
+		query.found = false;
+		query.distance = INFINITE_DISTANCE;
+		ResetSearchStats(query.stats);
+		queries.add(query);
+	}
+	return true;
+}
+
+/* Writes the node names along path, which is in the order of ExtractPath, from start to its far end */
+static void WritePath(ofstream &out, Stack<arcT *> path, nodeT *start){
+	Vector<arcT *> arcs;
+	while(!path.isEmpty())
+		arcs.add(path.pop());
+	nodeT *node = start;
+	out << node->name;
+	for(int i = arcs.size() - 1; i >= 0; i--){
+		node = OtherEnd(arcs[i], node);
+		out << " " << node->name;
+	}
+}
+
+bool RunBatch(batchSettingsT &settings){
+	graphT graph;
+	if(!LoadBatchGraph(settings.graphFile, graph)){
+		cout << "Cannot open graph file " << settings.graphFile << endl;
+		return false;
+	}
+	Vector<batchQueryT> queries;
+	if(!ReadQueries(settings.queryFile, graph, queries)){
+		cout << "Cannot open query file " << settings.queryFile << endl;
+		FreeGraph(graph);
+		return false;
+	}
+	ofstream out(settings.outputFile.c_str());
+	if(out.fail()){
+		cout << "Cannot open output file " << settings.outputFile << endl;
+		FreeGraph(graph);
+		return false;
+	}
+
+	// Checked here rather than on the worker threads, where the search would report it once per query
+	if(graph.negativeArcs > 0){
+		cout << "Cannot search graph file " << settings.graphFile << ": negative arc distances are not supported"
+		     << endl;
+		FreeGraph(graph);
+		return false;
+	}
+
+	// From here on the graph and its preprocessed data are only read
+	PrepareSearchMode(graph, settings.mode);
+	int numThreads = (settings.numThreads < 1) ? 1 : settings.numThreads;
+	Vector<queryScratchT> scratch;
+	for(int t = 0; t < numThreads; t++)
+		scratch.add(queryScratchT());
+	chrono::steady_clock::time_point batchStart = chrono::steady_clock::now();
+	ParallelFor(queries.size(), numThreads, [&](int i, int thread){
+		batchQueryT &query = queries[i];
+		if(query.start == NULL || query.end == NULL) return;
+		int dequeues;
+		query.found = RunQuery(graph, settings.mode, query.start, query.end, scratch[thread], query.path,
+		                       query.distance, dequeues, &query.stats);
+	});
+	double seconds = chrono::duration<double>(chrono::steady_clock::now() - batchStart).count();
+
+	double totalMicroseconds = 0;
+	Vector<searchStatsT> allStats;  // of the queries that ran
+	for(int i = 0; i < queries.size(); i++){
+		batchQueryT &query = queries[i];
+		out << query.startName << "\t" << query.endName << "\t";
+		if(query.start == NULL || query.end == NULL)
+			out << "unknown\t0\t";
+		else if(!query.found)
+			out << "unreachable\t" << query.stats.microseconds << "\t";
+		else{
+			out << query.distance << "\t" << query.stats.microseconds << "\t";
+			WritePath(out, query.path, query.start);
+		}
+		out << endl;
+		if(query.start != NULL && query.end != NULL)
+			allStats.add(query.stats);
+		totalMicroseconds += query.stats.microseconds;
+	}
+	out.close();
+	cout << "Answered " << queries.size() << " queries with " << SearchModeName(settings.mode) << " on "
+	     << numThreads << " threads in " << seconds << " s" << endl;
+	if(seconds > 0)
+		cout << "Throughput: " << queries.size() / seconds << " queries/s" << endl;
+	if(queries.size() > 0)
+		cout << "Average latency: " << totalMicroseconds / queries.size() << " us" << endl;
+	PrintTreeCacheCounters(graph);
+	PrintSearchStatsReport(allStats, cout);
+	FreeGraph(graph);
+	if(settings.statsFile != ""){
+		string name = settings.statsFile;
+		bool isJSON = name.size() >= 5 && name.substr(name.size() - 5) == ".json";
+		if(!(isJSON ? WriteSearchStatsJSON(allStats, name) : WriteSearchStatsCSV(allStats, name))){
+			cout << "Cannot write stats file " << name << endl;
+			return false;
+		}
+	}
+	return !out.fail();
+}
+
+bool RunScalingBenchmark(string text){
+	istringstream in(text);
+	string graphFile;
+	int maxThreads = DefaultThreadCount();
+	int sourceCount = 10;
+	if(!(in >> graphFile)) return false;
+	if(in >> maxThreads){
+		if(maxThreads < 1) return false;
+		if(in >> sourceCount){
+			if(sourceCount < 1) return false;
+		}
+	}
+	if(!in.eof()) return false;
+	graphT graph;
+	if(!LoadBatchGraph(graphFile, graph)){
+		cout << "Cannot open graph file " << graphFile << endl;
+		return false;
+	}
+	BenchmarkDeltaStepping(graph, maxThreads, sourceCount);
+	cout << endl;
+	BenchmarkSpanningTrees(graph, maxThreads);
+	FreeGraph(graph);
+	return true;
+}
@@ -0,0 +1,75 @@
+/*
+ * File: batch.h
+ * -------------
+ * This module exports the batch mode of the pathfinder: it reads a graph and a file of queries, answers the queries
+ * on a pool of worker threads and writes the results to a file, without any graphics or user input. The program
+ * runs in batch mode when the environment variable PATHFINDER_BATCH is set, which is how it is driven from a job
+ * (the library's main function takes no command line arguments).
+ */
+
+#ifndef _batch_h
+#define _batch_h
+
+#include "genlib.h"
+#include "query.h"
+
+/* Name of the environment variable that switches the program to batch mode */
+const string BATCH_VARIABLE = "PATHFINDER_BATCH";
+
+/* Name of the environment variable that runs the thread scaling benchmark instead */
+const string BENCHMARK_VARIABLE = "PATHFINDER_BENCHMARK";
+
+/*
+ * Type: batchSettingsT
+ * --------------------
+ * What a batch run does.
+ */
+struct batchSettingsT{
+	string graphFile;   // graph data file, in the same format as for the interactive program
+	string queryFile;   // one query per line: the names of the start and end nodes separated by white space
+	string outputFile;  // receives one line per query, see RunBatch
+	int numThreads;     // number of worker threads
+	searchModeT mode;   // search engine used for every query
+	string statsFile;   // receives the search counters of every query, "" for none
+};
+
+/*
+ * Function: ParseBatchSettings
+ * Usage: if(ParseBatchSettings(getenv("PATHFINDER_BATCH"), settings)) ...
+ * -----------------------------------------------------------------------
+ * Reads the settings from a string of the form
+ *     <graph file> <query file> <output file> [<threads> [<search mode> [<stats file>]]]
+ * where the search mode is numbered as in the interactive menu (1 Dijkstra's algorithm, 2 A*, 3 bidirectional,
+ * 4 contraction hierarchy, 5 A* with landmarks, 6 Dijkstra with cached shortest path trees). The thread count
+ * defaults to the number of hardware threads and the mode to Dijkstra's algorithm. The stats file is written as
+ * JSON if its name ends in ".json" and as CSV otherwise. Returns false if the string is malformed.
+ */
+bool ParseBatchSettings(string text, batchSettingsT &settings);
+
+/*
+ * Function: RunBatch
+ * Usage: if(!RunBatch(settings)) ...
+ * ----------------------------------
+ * Answers every query of the query file and writes one tab separated line per query to the output file, in the
+ * order of the query file:
+ *     <start> <end> <distance> <microseconds> <node names of the path from start to end>
+ * The distance is "unreachable" if there is no path and "unknown" if a node name is not in the graph. The graph and
+ * its preprocessed data are shared read only by the workers, and each worker reuses its own scratch state. Prints
+ * the total time, the throughput and the search statistics report, and exports the counters of every query if a
+ * stats file is set. Returns false if a file cannot be opened.
+ */
+bool RunBatch(batchSettingsT &settings);
+
+/*
+ * Function: RunScalingBenchmark
+ * Usage: if(!RunScalingBenchmark(getenv("PATHFINDER_BENCHMARK"))) ...
+ * -------------------------------------------------------------------
+ * Reads the graph named by a string of the form
+ *     <graph file> [<max threads> [<sources>]]
+ * and runs BenchmarkDeltaStepping and BenchmarkSpanningTrees on it. The thread count defaults to the number of
+ * hardware threads and the number of sources to 10. Returns false if the string is malformed or the graph file cannot
+ * be opened.
+ */
+bool RunScalingBenchmark(string text);
+
+#endif
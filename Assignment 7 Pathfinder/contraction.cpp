@@ -0,0 +1,568 @@
+/*
+ * File: contraction.cpp
+ * ---------------------
+ * This file implements the Contraction Hierarchies engine: the node ordering and contraction, the text file format
+ * of the overlay and the upward bidirectional query with shortcut unpacking.
+ */
+
+#include <iostream>
+#include <fstream>
+#include "contraction.h"
+#include "shortestpath.h"
+#include "pqueue.h"
+#include "parallel.h"
+#include "searchstats.h"
+
+/* Witness searches give up after settling this many nodes; the shortcut is then added to be on the safe side */
+const int WITNESS_SETTLE_LIMIT = 100;
+
+/* Neighbour priorities are recomputed on several threads only when there are at least this many of them */
+const int PARALLEL_UPDATE_THRESHOLD = 8;
+
+/*
+ * Type: chEntryT
+ * --------------
+ * An entry of the contraction order queue (key is the node priority) or of a search queue (key is the distance).
+ */
+struct chEntryT{
+	int node;
+	int key;
+};
+
+/* Function: CmpByContractionKey
+ * -----------------------------
+ * Callback for the queues of this module. The entry with less key is given higher priority, ties go to the lower
+ * node id so that the contraction order never depends on the order of enqueues.
+ */
+int CmpByContractionKey(chEntryT entry1, chEntryT entry2){
+	STATS_ADD(comparisons, 1);
+	if(entry1.key != entry2.key)
+		return (entry1.key < entry2.key) ? 1 : -1;
+	if(entry1.node != entry2.node)
+		return (entry1.node < entry2.node) ? 1 : -1;
+	return 0;
+}
+
+/* ============================ Preprocessing ============================== */
+/*
+ * Type: chBuildT
+ * --------------
+ * The graph while it is being contracted. adj holds the arcs and shortcuts between uncontracted nodes in both
+ * directions, at most one per pair of nodes.
+ */
+struct chBuildT{
+	Vector< Vector<chEdgeT> > adj;
+	Vector<bool> contracted;
+	Vector<int> deletedNeighbours;  // number of contracted neighbours of each node
+};
+
+/*
+ * Type: witnessScratchT
+ * ---------------------
+ * Per thread scratch state of the witness searches, indexed by node id.
+ */
+struct witnessScratchT{
+	Vector<int> dist;     // INFINITE_DISTANCE unless the node is in touched
+	Vector<int> handle;
+	Vector<int> touched;
+	Vector<int> slot;     // position of the node in the neighbour list being collected, -1 otherwise
+};
+
+/* A shortcut node1 - middle - node2 that contracting middle requires */
+struct shortcutT{
+	int node1, node2;
+	int distance;
+	int half1, half2;
+};
+
+/* Sizes a scratch state for nodeCount nodes */
+static void InitWitnessScratch(witnessScratchT &scratch, int nodeCount){
+	for(int i = 0; i < nodeCount; i++){
+		scratch.dist.add(INFINITE_DISTANCE);
+		scratch.handle.add(-1);
+		scratch.slot.add(-1);
+	}
+}
+
+/*
+ * Function: CollectNeighbours
+ * ---------------------------
+ * Lists the uncontracted neighbours of node, keeping only the shortest arc to each.
+ */
+static void CollectNeighbours(chBuildT &build, int node, witnessScratchT &scratch, Vector<chEdgeT> &neighbours){
+	Vector<chEdgeT> &edges = build.adj[node];
+	for(int i = 0; i < edges.size(); i++){
+		chEdgeT edge = edges[i];
+		if(build.contracted[edge.node] || edge.node == node) continue;
+		int slot = scratch.slot[edge.node];
+		if(slot == -1){
+			scratch.slot[edge.node] = neighbours.size();
+			neighbours.add(edge);
+		}
+		else if(edge.distance < neighbours[slot].distance)
+			neighbours[slot] = edge;
+	}
+	for(int i = 0; i < neighbours.size(); i++)
+		scratch.slot[neighbours[i].node] = -1;
+}
+
+/*
+ * Function: WitnessSearch
+ * -----------------------
+ * Runs Dijkstra's algorithm from source over the uncontracted nodes other than avoid. It stops once the targets
+ * neighbours[firstTarget ..] are all settled, beyond maxDistance, or after WITNESS_SETTLE_LIMIT settled nodes.
+ * Afterwards scratch.dist holds an upper bound of the distance from source around avoid for every node
+ * (INFINITE_DISTANCE if none was found).
+ */
+static void WitnessSearch(chBuildT &build, witnessScratchT &scratch, int source, int avoid, int maxDistance,
+                          Vector<chEdgeT> &neighbours, int firstTarget){
+	for(int i = 0; i < scratch.touched.size(); i++)
+		scratch.dist[scratch.touched[i]] = INFINITE_DISTANCE;
+	scratch.touched.clear();
+	int targetsLeft = neighbours.size() - firstTarget;
+	for(int i = firstTarget; i < neighbours.size(); i++)
+		scratch.slot[neighbours[i].node] = i;
+	IndexedPQueue<chEntryT> pq(CmpByContractionKey);
+	scratch.dist[source] = 0;
+	scratch.touched.add(source);
+	chEntryT first = {source, 0};
+	scratch.handle[source] = pq.enqueue(first);
+	int settled = 0;
+	while(!pq.isEmpty()){
+		chEntryT entry = pq.dequeueMax();
+		if(entry.key > maxDistance || ++settled > WITNESS_SETTLE_LIMIT) break;
+		if(scratch.slot[entry.node] != -1 && --targetsLeft == 0) break;
+		Vector<chEdgeT> &edges = build.adj[entry.node];
+		for(int i = 0; i < edges.size(); i++){
+			chEdgeT edge = edges[i];
+			if(build.contracted[edge.node] || edge.node == avoid) continue;
+			int newDistance = entry.key + edge.distance;
+			if(newDistance < scratch.dist[edge.node]){
+				bool queued = (scratch.dist[edge.node] != INFINITE_DISTANCE);
+				scratch.dist[edge.node] = newDistance;
+				chEntryT newEntry = {edge.node, newDistance};
+				if(queued)
+					pq.increaseKey(scratch.handle[edge.node], newEntry);
+				else{
+					scratch.touched.add(edge.node);
+					scratch.handle[edge.node] = pq.enqueue(newEntry);
+				}
+			}
+		}
+	}
+	for(int i = firstTarget; i < neighbours.size(); i++)
+		scratch.slot[neighbours[i].node] = -1;
+}
+
+/*
+ * Function: FindShortcuts
+ * -----------------------
+ * Simulates contracting node: for every pair of its uncontracted neighbours, adds a shortcut if no witness path is at
+ * most as short as the path through node. One witness search per neighbour covers all pairs with later neighbours.
+ */
+static void FindShortcuts(chBuildT &build, int node, witnessScratchT &scratch, Vector<chEdgeT> &neighbours,
+                          Vector<shortcutT> &shortcuts){
+	CollectNeighbours(build, node, scratch, neighbours);
+	for(int i = 0; i < neighbours.size() - 1; i++){
+		chEdgeT from = neighbours[i];
+		int maxDistance = 0;
+		for(int j = i + 1; j < neighbours.size(); j++)
+			if(neighbours[j].distance > maxDistance) maxDistance = neighbours[j].distance;
+		WitnessSearch(build, scratch, from.node, node, from.distance + maxDistance, neighbours, i + 1);
+		for(int j = i + 1; j < neighbours.size(); j++){
+			chEdgeT to = neighbours[j];
+			int via = from.distance + to.distance;
+			if(scratch.dist[to.node] > via){
+				shortcutT shortcut = {from.node, to.node, via, from.chArc, to.chArc};
+				shortcuts.add(shortcut);
+			}
+		}
+	}
+}
+
+/*
+ * Function: AddBuildEdge
+ * ----------------------
+ * Links hierarchy arc chArc between node1 and node2 into the adjacency lists, replacing a longer arc between the
+ * same nodes. Does nothing if there is already one at least as short.
+ */
+static void AddBuildEdge(chBuildT &build, int node1, int node2, int distance, int chArc){
+	Vector<chEdgeT> &edges1 = build.adj[node1];
+	for(int i = 0; i < edges1.size(); i++){
+		if(edges1[i].node != node2) continue;
+		if(edges1[i].distance <= distance) return;
+		Vector<chEdgeT> &edges2 = build.adj[node2];
+		for(int j = 0; j < edges2.size(); j++){
+			if(edges2[j].node == node1){
+				chEdgeT backward = {node1, distance, chArc};
+				edges2[j] = backward;
+			}
+		}
+		chEdgeT forward = {node2, distance, chArc};
+		edges1[i] = forward;
+		return;
+	}
+	chEdgeT forward = {node2, distance, chArc};
+	chEdgeT backward = {node1, distance, chArc};
+	edges1.add(forward);
+	build.adj[node2].add(backward);
+}
+
+/* Unlinks the arcs to node from the adjacency list of neighbour */
+static void RemoveBuildEdges(chBuildT &build, int neighbour, int node){
+	Vector<chEdgeT> &edges = build.adj[neighbour];
+	int kept = 0;
+	for(int i = 0; i < edges.size(); i++)
+		if(edges[i].node != node) edges[kept++] = edges[i];
+	while(edges.size() > kept)
+		edges.removeAt(edges.size() - 1);
+}
+
+/* Edge difference plus contracted neighbours: the lower, the earlier the node is contracted */
+static int ComputePriority(chBuildT &build, int node, witnessScratchT &scratch){
+	Vector<chEdgeT> neighbours;
+	Vector<shortcutT> shortcuts;
+	FindShortcuts(build, node, scratch, neighbours, shortcuts);
+	return shortcuts.size() - neighbours.size() + build.deletedNeighbours[node];
+}
+
+/* Fills ch.up from ch.arcs and ch.rank */
+static void BuildUpwardLists(contractionHierarchyT &ch){
+	ch.up.clear();
+	for(int i = 0; i < ch.rank.size(); i++)
+		ch.up.add(Vector<chEdgeT>());
+	for(int i = 0; i < ch.arcs.size(); i++){
+		chArcT arc = ch.arcs[i];
+		if(arc.node1 == arc.node2) continue;
+		if(ch.rank[arc.node1] < ch.rank[arc.node2]){
+			chEdgeT edge = {arc.node2, arc.distance, i};
+			ch.up[arc.node1].add(edge);
+		}
+		else{
+			chEdgeT edge = {arc.node1, arc.distance, i};
+			ch.up[arc.node2].add(edge);
+		}
+	}
+}
+
+/* Contracts the nodes in order of priority, adding shortcuts as needed */
+void BuildContractionHierarchy(graphT &graph, contractionHierarchyT &ch, int numThreads){
+	int nodeCount = graph.nodeList.size();
+	if(numThreads < 1) numThreads = 1;
+	chBuildT build;
+	ch.rank.clear();
+	ch.arcs.clear();
+	for(int i = 0; i < nodeCount; i++){
+		build.adj.add(Vector<chEdgeT>());
+		build.contracted.add(false);
+		build.deletedNeighbours.add(0);
+		ch.rank.add(-1);
+	}
+	for(int i = 0; i < graph.arcs.size(); i++){
+		arcT *arc = graph.arcs[i];
+		chArcT chArc = {arc->start->id, arc->end->id, arc->distance, -1, -1, -1};
+		ch.arcs.add(chArc);
+		if(arc->start != arc->end)
+			AddBuildEdge(build, arc->start->id, arc->end->id, arc->distance, i);
+	}
+	ch.graphArcCount = graph.arcs.size();
+	ch.distanceSum = SumOfArcDistances(graph);
+
+	Vector<witnessScratchT> scratch;
+	for(int t = 0; t < numThreads; t++){
+		scratch.add(witnessScratchT());
+		InitWitnessScratch(scratch[t], nodeCount);
+	}
+
+	// Initial priorities: independent for every node, so they are computed in parallel
+	Vector<int> priority;
+	for(int i = 0; i < nodeCount; i++)
+		priority.add(0);
+	ParallelFor(nodeCount, numThreads, [&](int node, int thread){
+		priority[node] = ComputePriority(build, node, scratch[thread]);
+	});
+	IndexedPQueue<chEntryT> pq(CmpByContractionKey);
+	Vector<int> handle;
+	for(int i = 0; i < nodeCount; i++){
+		chEntryT entry = {i, priority[i]};
+		handle.add(pq.enqueue(entry));
+	}
+
+	int nextRank = 0;
+	while(!pq.isEmpty()){
+		int node = pq.dequeueMax().node;
+		Vector<chEdgeT> neighbours;
+		Vector<shortcutT> shortcuts;
+		FindShortcuts(build, node, scratch[0], neighbours, shortcuts);
+		// Lazy update: if the priority got worse since it was computed, put the node back
+		chEntryT current = {node, shortcuts.size() - neighbours.size() + build.deletedNeighbours[node]};
+		if(!pq.isEmpty() && CmpByContractionKey(current, pq.peekMax()) < 0){
+			handle[node] = pq.enqueue(current);
+			continue;
+		}
+
+		for(int i = 0; i < shortcuts.size(); i++){
+			shortcutT shortcut = shortcuts[i];
+			chArcT chArc = {shortcut.node1, shortcut.node2, shortcut.distance, node, shortcut.half1, shortcut.half2};
+			AddBuildEdge(build, shortcut.node1, shortcut.node2, shortcut.distance, ch.arcs.size());
+			ch.arcs.add(chArc);
+		}
+		build.contracted[node] = true;
+		for(int i = 0; i < neighbours.size(); i++)
+			RemoveBuildEdges(build, neighbours[i].node, node);
+		ch.rank[node] = nextRank++;
+
+		// The neighbours lost an arc and may have gained shortcuts, so their priorities change
+		for(int i = 0; i < neighbours.size(); i++)
+			build.deletedNeighbours[neighbours[i].node]++;
+		int updateThreads = (neighbours.size() >= PARALLEL_UPDATE_THRESHOLD) ? numThreads : 1;
+		ParallelFor(neighbours.size(), updateThreads, [&](int i, int thread){
+			priority[neighbours[i].node] = ComputePriority(build, neighbours[i].node, scratch[thread]);
+		});
+		for(int i = 0; i < neighbours.size(); i++){
+			int neighbour = neighbours[i].node;
+			chEntryT updated = {neighbour, priority[neighbour]};
+			int cmp = CmpByContractionKey(updated, pq.getElement(handle[neighbour]));
+			if(cmp > 0)
+				pq.increaseKey(handle[neighbour], updated);
+			else if(cmp < 0)
+				pq.decreaseKey(handle[neighbour], updated);
+		}
+	}
+	BuildUpwardLists(ch);
+}
+
+/* ============================ Overlay file ============================== */
+/*
+ * File format:
+ *     HIERARCHY <nodes> <graph arcs> <sum of graph arc distances>
+ *     RANKS
+ *     <rank of node 0>
+ *     ...
+ *     SHORTCUTS <count>
+ *     <node1> <node2> <middle> <distance> <half1> <half2>
+ *     ...
+ */
+bool SaveContractionHierarchy(contractionHierarchyT &ch, string filename){
+	ofstream out(filename.c_str());
+	if(out.fail()) return false;
+	out << "HIERARCHY " << ch.rank.size() << " " << ch.graphArcCount << " " << ch.distanceSum << endl;
+	out << "RANKS" << endl;
+	for(int i = 0; i < ch.rank.size(); i++)
+		out << ch.rank[i] << endl;
+	out << "SHORTCUTS " << ch.arcs.size() - ch.graphArcCount << endl;
+	for(int i = ch.graphArcCount; i < ch.arcs.size(); i++){
+		chArcT arc = ch.arcs[i];
+		out << arc.node1 << " " << arc.node2 << " " << arc.middle << " " << arc.distance << " "
+		    << arc.half1 << " " << arc.half2 << endl;
+	}
+	return !out.fail();
+}
+
+bool LoadContractionHierarchy(graphT &graph, contractionHierarchyT &ch, string filename){
+	ifstream in(filename.c_str());
+	if(in.fail()) return false;
+	string text;
+	int nodeCount, arcCount, shortcutCount;
+	long long distanceSum;
+	in >> text >> nodeCount >> arcCount >> distanceSum;
+	if(in.fail() || text != "HIERARCHY" || nodeCount != graph.nodeList.size() || arcCount != graph.arcs.size() ||
+	   distanceSum != SumOfArcDistances(graph))
+		return false;  // built for another graph
+	ch.rank.clear();
+	ch.arcs.clear();
+	in >> text;  // RANKS
+	for(int i = 0; i < nodeCount; i++){
+		int rank;
+		in >> rank;
+		ch.rank.add(rank);
+	}
+	for(int i = 0; i < arcCount; i++){
+		arcT *arc = graph.arcs[i];
+		chArcT chArc = {arc->start->id, arc->end->id, arc->distance, -1, -1, -1};
+		ch.arcs.add(chArc);
+	}
+	in >> text >> shortcutCount;  // SHORTCUTS
+	for(int i = 0; i < shortcutCount; i++){
+		chArcT arc;
+		in >> arc.node1 >> arc.node2 >> arc.middle >> arc.distance >> arc.half1 >> arc.half2;
+		ch.arcs.add(arc);
+	}
+	if(in.fail()) return false;
+	ch.graphArcCount = arcCount;
+	ch.distanceSum = distanceSum;
+	BuildUpwardLists(ch);
+	return true;
+}
+
+/* Loads the hierarchy saved next to the graph file, or builds and saves it; only builds it once arcs have changed */
+contractionHierarchyT *GetContractionHierarchy(graphT &graph){
+	if(graph.hierarchy != NULL) return graph.hierarchy;
+	contractionHierarchyT *ch = new contractionHierarchyT;
+	string filename = graph.fileName + ".ch";
+	bool asRead = (graph.updates == 0);  // the file describes the graph as it was read
+	ch->loaded = asRead && LoadContractionHierarchy(graph, *ch, filename);
+	ch->saved = false;
+	if(!ch->loaded){
+		BuildContractionHierarchy(graph, *ch, DefaultThreadCount());
+		ch->saved = asRead && SaveContractionHierarchy(*ch, filename);
+	}
+	graph.hierarchy = ch;
+	return ch;
+}
+
+/* ============================ Query ============================== */
+/* Sizes the query state, or resets the nodes touched by the previous query */
+static void InitQueryState(chQueryStateT &state, int nodeCount){
+	if(state.forward.dist.size() != nodeCount){
+		chSideT *sides[] = {&state.forward, &state.backward};
+		for(int s = 0; s < 2; s++){
+			sides[s]->dist.clear();
+			sides[s]->pred.clear();
+			sides[s]->handle.clear();
+			for(int i = 0; i < nodeCount; i++){
+				sides[s]->dist.add(INFINITE_DISTANCE);
+				sides[s]->pred.add(-1);
+				sides[s]->handle.add(-1);
+			}
+		}
+	}
+	else{
+		for(int i = 0; i < state.touched.size(); i++){
+			int node = state.touched[i];
+			state.forward.dist[node] = state.backward.dist[node] = INFINITE_DISTANCE;
+			state.forward.pred[node] = state.backward.pred[node] = -1;
+		}
+	}
+	state.touched.clear();
+	state.meetingNode = -1;
+	state.distance = INFINITE_DISTANCE;
+	state.dequeues = 0;
+}
+
+/* Gives node a new distance on one side and enqueues it or moves it up */
+static void Reach(chQueryStateT &state, chSideT &side, IndexedPQueue<chEntryT> &pq, int node, int distance,
+                  int chArc){
+	bool queued = (side.dist[node] != INFINITE_DISTANCE);
+	if(state.forward.dist[node] == INFINITE_DISTANCE && state.backward.dist[node] == INFINITE_DISTANCE)
+		state.touched.add(node);
+	side.dist[node] = distance;
+	side.pred[node] = chArc;
+	chEntryT entry = {node, distance};
+	if(queued){
+		pq.increaseKey(side.handle[node], entry);
+		STATS_ADD(decreaseKeys, 1);
+	}
+	else{
+		side.handle[node] = pq.enqueue(entry);
+		STATS_ADD(pushes, 1);
+		STATS_MAX(maxQueueSize, pq.size());
+	}
+}
+
+/* Settles the top node of one side, checks it as a meeting node and relaxes its upward arcs */
+static void ScanUpward(contractionHierarchyT &ch, IndexedPQueue<chEntryT> &pq, chSideT &side, chSideT &other,
+                       chQueryStateT &state){
+	chEntryT entry = pq.dequeueMax();
+	state.dequeues++;
+	STATS_ADD(pops, 1);
+	STATS_ADD(settled, 1);
+	int node = entry.node;
+	if(other.dist[node] != INFINITE_DISTANCE && entry.key + other.dist[node] < state.distance){
+		state.distance = entry.key + other.dist[node];
+		state.meetingNode = node;
+	}
+	Vector<chEdgeT> &edges = ch.up[node];
+	STATS_ADD(relaxed, edges.size());
+	for(int i = 0; i < edges.size(); i++){
+		int newDistance = entry.key + edges[i].distance;
+		if(newDistance < side.dist[edges[i].node])
+			Reach(state, side, pq, edges[i].node, newDistance, edges[i].chArc);
+	}
+}
+
+/* Upward search from both ends till neither side can improve the best path */
+bool FindShortestPathCH(graphT &graph, contractionHierarchyT &ch, nodeT *source, nodeT *target,
+                        chQueryStateT &state){
+	InitQueryState(state, graph.nodeList.size());
+	IndexedPQueue<chEntryT> forwardPQ(CmpByContractionKey), backwardPQ(CmpByContractionKey);
+	Reach(state, state.forward, forwardPQ, source->id, 0, -1);
+	Reach(state, state.backward, backwardPQ, target->id, 0, -1);
+	while(true){
+		bool forwardActive = !forwardPQ.isEmpty() && forwardPQ.peekMax().key < state.distance;
+		bool backwardActive = !backwardPQ.isEmpty() && backwardPQ.peekMax().key < state.distance;
+		if(!forwardActive && !backwardActive) break;
+		if(forwardActive && (!backwardActive || forwardPQ.peekMax().key <= backwardPQ.peekMax().key))
+			ScanUpward(ch, forwardPQ, state.forward, state.backward, state);
+		else
+			ScanUpward(ch, backwardPQ, state.backward, state.forward, state);
+	}
+	return state.distance != INFINITE_DISTANCE;
+}
+
+/* Returns the end point of the hierarchy arc that is not node */
+static int OtherChEnd(chArcT &arc, int node){
+	return (arc.node1 == node) ? arc.node2 : arc.node1;
+}
+
+/* A hierarchy arc still to be unpacked, and the end point it is entered from */
+struct pendingArcT{
+	int chArc;
+	int from;
+};
+
+/*
+ * Function: UnpackArc
+ * -------------------
+ * Pushes the graph arcs a hierarchy arc stands for onto path, in the order they are travelled when entering the
+ * hierarchy arc from node from. Uses an explicit stack, since shortcuts can nest deeply.
+ */
+static void UnpackArc(graphT &graph, contractionHierarchyT &ch, int chArc, int from, Stack<arcT *> &path){
+	Stack<pendingArcT> pending;
+	pendingArcT first = {chArc, from};
+	pending.push(first);
+	while(!pending.isEmpty()){
+		pendingArcT next = pending.pop();
+		chArcT arc = ch.arcs[next.chArc];
+		if(arc.middle == -1){
+			path.push(graph.arcs[next.chArc]);
+			continue;
+		}
+		// Push the half travelled second first, so the first half is unpacked first
+		if(next.from == arc.node1){
+			pendingArcT second = {arc.half2, arc.middle}, firstHalf = {arc.half1, arc.node1};
+			pending.push(second);
+			pending.push(firstHalf);
+		}
+		else{
+			pendingArcT second = {arc.half1, arc.middle}, firstHalf = {arc.half2, arc.node2};
+			pending.push(second);
+			pending.push(firstHalf);
+		}
+	}
+}
+
+/* Unpacks source -> meeting node (forward half, reversed) and meeting node -> target (backward half) */
+Stack<arcT *> ExtractPathCH(graphT &graph, contractionHierarchyT &ch, chQueryStateT &state, nodeT *source,
+                            nodeT *target){
+	Stack<arcT *> path;
+	if(state.distance == INFINITE_DISTANCE) return path;
+	Vector<int> forwardArcs, forwardFrom;  // from the meeting node back to source
+	int node = state.meetingNode;
+	while(node != source->id){
+		int chArc = state.forward.pred[node];
+		int previous = OtherChEnd(ch.arcs[chArc], node);
+		forwardArcs.add(chArc);
+		forwardFrom.add(previous);
+		node = previous;
+	}
+	for(int i = forwardArcs.size() - 1; i >= 0; i--)
+		UnpackArc(graph, ch, forwardArcs[i], forwardFrom[i], path);
+	node = state.meetingNode;
+	while(node != target->id){
+		int chArc = state.backward.pred[node];
+		UnpackArc(graph, ch, chArc, node, path);
+		node = OtherChEnd(ch.arcs[chArc], node);
+	}
+	return path;
+}
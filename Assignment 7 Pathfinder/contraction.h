@@ -0,0 +1,131 @@
+/*
+ * File: contraction.h
+ * -------------------
+ * This module exports a Contraction Hierarchies engine for answering many point-to-point queries on a graph that
+ * does not change. An offline pass contracts the nodes one by one in order of importance and adds a shortcut arc
+ * wherever contracting a node would otherwise lengthen a shortest path. A query then only needs two small searches
+ * that each climb to more important nodes, and the shortcuts on the result are unpacked back into graph arcs.
+ * The hierarchy is saved next to the graph file so it only has to be built once.
+ */
+
+#ifndef _contraction_h
+#define _contraction_h
+
+#include "genlib.h"
+#include "vector.h"
+#include "stack.h"
+#include "pathgraph.h"
+
+/*
+ * Type: chArcT
+ * ------------
+ * An arc of the hierarchy. The first arcs of a hierarchy are the graph arcs themselves (hierarchy arc i is graph arc
+ * i); after them come the shortcuts, each standing for two hierarchy arcs through a node contracted earlier.
+ */
+struct chArcT{
+	int node1, node2;  // end point ids
+	int distance;
+	int middle;        // for a shortcut, the contracted node it bypasses; -1 for a graph arc
+	int half1, half2;  // for a shortcut, the hierarchy arcs node1 - middle and middle - node2
+};
+
+/*
+ * Type: chEdgeT
+ * -------------
+ * An entry of the upward adjacency lists: a hierarchy arc seen from its less important end.
+ */
+struct chEdgeT{
+	int node;      // the more important end point
+	int distance;
+	int chArc;     // index into contractionHierarchyT::arcs
+};
+
+/*
+ * Type: contractionHierarchyT
+ * ---------------------------
+ * The preprocessed overlay of a graph.
+ */
+struct contractionHierarchyT{
+	Vector<int> rank;             // position of each node id in the contraction order
+	Vector<chArcT> arcs;          // graph arcs followed by shortcuts
+	Vector< Vector<chEdgeT> > up; // for each node id, its hierarchy arcs to more important nodes
+	int graphArcCount;            // number of graph arcs at the front of arcs
+	long long distanceSum;        // sum of all graph arc distances when the hierarchy was built
+	bool loaded;                  // read from the file next to the graph file rather than built
+	bool saved;                   // built and written to the file next to the graph file
+};
+
+/*
+ * Type: chSideT, chQueryStateT
+ * ----------------------------
+ * The scratch state of a hierarchy query. Only the nodes in touched are reset between queries, since the upward
+ * searches reach a tiny part of the graph.
+ */
+struct chSideT{
+	Vector<int> dist;    // distance from this side's end point
+	Vector<int> pred;    // hierarchy arc on which the node was reached, -1 if none
+	Vector<int> handle;  // priority queue handle of the node while it is in the queue
+};
+struct chQueryStateT{
+	chSideT forward;     // upward search from the source
+	chSideT backward;    // upward search from the target
+	Vector<int> touched; // nodes with a finite distance on either side
+	int meetingNode;     // most important node of the best path, -1 if none
+	int distance;        // length of the best path found, INFINITE_DISTANCE if none
+	int dequeues;        // entries removed from both priority queues by the last query
+};
+
+/*
+ * Function: BuildContractionHierarchy
+ * Usage: BuildContractionHierarchy(graph, ch, DefaultThreadCount());
+ * ------------------------------------------------------------------
+ * Builds the hierarchy of the graph. Nodes are contracted in order of their edge difference (shortcuts the
+ * contraction would add minus arcs it removes) plus the number of already contracted neighbours, lowest first, with
+ * ties broken by node id. A shortcut is only added if a bounded witness search cannot find an equally short path
+ * around the node. The initial priorities, which need one witness search per arc, are computed on numThreads
+ * threads; the result does not depend on the number of threads.
+ */
+void BuildContractionHierarchy(graphT &graph, contractionHierarchyT &ch, int numThreads);
+
+/*
+ * Function: SaveContractionHierarchy, LoadContractionHierarchy
+ * Usage: SaveContractionHierarchy(ch, filename);
+ *        if(LoadContractionHierarchy(graph, ch, filename)) ...
+ * -----------------------------------------------------------
+ * Writes the node order and the shortcuts to a text file, or reads them back. The graph arcs are not stored, they
+ * are taken from the graph. Loading fails if the file is missing or was built for a different graph.
+ */
+bool SaveContractionHierarchy(contractionHierarchyT &ch, string filename);
+bool LoadContractionHierarchy(graphT &graph, contractionHierarchyT &ch, string filename);
+
+/*
+ * Function: GetContractionHierarchy
+ * Usage: contractionHierarchyT *ch = GetContractionHierarchy(graph);
+ * ------------------------------------------------------------------
+ * Returns graph.hierarchy, first loading it from the file next to the graph file or, if there is none, building
+ * and saving it. Once arc distances have been updated it is built in memory only. Prints nothing; the loaded and
+ * saved fields tell the caller which of these happened.
+ */
+contractionHierarchyT *GetContractionHierarchy(graphT &graph);
+
+/*
+ * Function: FindShortestPathCH
+ * Usage: if(FindShortestPathCH(graph, ch, source, target, state)) ...
+ * -------------------------------------------------------------------
+ * Answers a query with two upward searches, one from each end point. Each side stops once its smallest key is no
+ * shorter than the best path found. Returns false if target cannot be reached from source.
+ */
+bool FindShortestPathCH(graphT &graph, contractionHierarchyT &ch, nodeT *source, nodeT *target,
+                        chQueryStateT &state);
+
+/*
+ * Function: ExtractPathCH
+ * Usage: Stack<arcT *> path = ExtractPathCH(graph, ch, state, source, target);
+ * ----------------------------------------------------------------------------
+ * Returns the graph arcs of the path found by FindShortestPathCH, with every shortcut unpacked, in the same order as
+ * ExtractPath. Returns an empty stack if target was not reached.
+ */
+Stack<arcT *> ExtractPathCH(graphT &graph, contractionHierarchyT &ch, chQueryStateT &state, nodeT *source,
+                            nodeT *target);
+
+#endif
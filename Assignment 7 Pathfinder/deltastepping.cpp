@@ -0,0 +1,249 @@
+/*
+ * File: deltastepping.cpp
+ * -----------------------
+ * This file implements delta-stepping: the choice of the bucket width, the bucket phases and the benchmark.
+ */
+
+#include <iostream>
+#include <chrono>
+#include "deltastepping.h"
+
+/*
+ * The tentative distance and predecessor arc of a node are packed into one 64 bit word, distance in the high half
+ * and arc id in the low half, so that relaxing an arc is a single atomic minimum. Once all arcs have been relaxed
+ * from their final distances, the word of each node holds its distance and the lowest id of the arcs that give it.
+ */
+typedef unsigned long long labelT;
+const labelT UNREACHED_LABEL = ~0ULL;
+const unsigned int NO_ARC = 0xFFFFFFFFu;
+
+/* Number of frontier nodes a thread takes at a time */
+const int SCAN_CHUNK = 64;
+
+static inline labelT MakeLabel(long long distance, unsigned int arcId){
+	return ((labelT)distance << 32) | arcId;
+}
+
+static inline int LabelDistance(labelT label){
+	return (int)(label >> 32);
+}
+
+/* Lowers *slot to label unless it is already lower; returns true if it was lowered */
+static inline bool AtomicMin(atomic<labelT> &slot, labelT label){
+	labelT current = slot.load(memory_order_relaxed);
+	while(label < current){
+		if(slot.compare_exchange_weak(current, label, memory_order_relaxed)) return true;
+	}
+	return false;
+}
+
+int ChooseDelta(graphT &graph){
+	if(graph.arcs.size() == 0) return 1;
+	long long sum = 0;
+	int shortest = INT_MAX;
+	for(int i = 0; i < graph.arcs.size(); i++){
+		int distance = graph.arcs[i]->distance;
+		if(distance < 1) return 0;
+		sum += distance;
+		if(distance < shortest) shortest = distance;
+	}
+	// Each arc appears in the arc lists of both end points
+	double meanDistance = double(sum) / graph.arcs.size();
+	double meanDegree = 2.0 * graph.arcs.size() / graph.nodeList.size();
+	int delta = int(meanDistance / meanDegree);
+	if(delta < shortest) delta = shortest;
+	return (delta < 1) ? 1 : delta;
+}
+
+/*
+ * Type: deltaStateT
+ * -----------------
+ * The shared state of one delta-stepping run. The buckets are cyclic: a relaxation from bucket i reaches at most
+ * bucket i + longest / delta, so that many slots plus one are enough. A node is put into a bucket again every time
+ * its distance is lowered; entries whose node has since moved to a lower bucket are skipped when the bucket is taken.
+ */
+struct deltaStateT{
+	graphT *graph;
+	int delta;
+	vector<atomic<labelT> > label;       // node id -> packed distance and predecessor
+	vector< vector<int> > buckets;       // slot -> node ids, bucket i lives in slot i % buckets.size()
+	long long pending;                   // entries in all buckets, stale ones included
+	vector< vector<int> > lowered;       // thread -> nodes whose distance it lowered in the current step
+	vector<int> scannedIn;               // node id -> last step that scanned it
+	vector<long long> settledIn;         // node id -> last bucket whose heavy pass includes it
+	int scans;
+};
+
+/* Relaxes the light or the heavy arcs of node, recording on behalf of thread the nodes it improves */
+static void RelaxArcs(deltaStateT &run, int node, bool light, int thread){
+	int distance = LabelDistance(run.label[node].load(memory_order_relaxed));
+	nodeT *from = run.graph->nodeList[node];
+	for(int i = 0; i < from->arcs.size(); i++){
+		arcT *arc = from->arcs[i];
+		if((arc->distance <= run.delta) != light) continue;
+		int next = OtherEnd(arc, from)->id;
+		if(AtomicMin(run.label[next], MakeLabel((long long)distance + arc->distance, arc->id)))
+			run.lowered[thread].push_back(next);
+	}
+}
+
+/* Files the nodes lowered during the last step into the buckets of their new distances */
+static void FileLoweredNodes(deltaStateT &run){
+	long long slots = run.buckets.size();
+	for(size_t t = 0; t < run.lowered.size(); t++){
+		vector<int> &nodes = run.lowered[t];
+		for(size_t i = 0; i < nodes.size(); i++){
+			long long bucket = LabelDistance(run.label[nodes[i]].load(memory_order_relaxed)) / run.delta;
+			run.buckets[bucket % slots].push_back(nodes[i]);
+			run.pending++;
+		}
+		nodes.clear();
+	}
+}
+
+void FindShortestPathTreeParallel(graphT &graph, nodeT *source, searchStateT &state, WorkerPool &pool, int delta){
+	if(delta <= 0) delta = ChooseDelta(graph);
+	if(delta <= 0 || graph.negativeArcs > 0){
+		FindShortestPath(graph, source, NULL, state);
+		return;
+	}
+	int nodeCount = graph.nodeList.size();
+	int longest = 0;
+	for(int i = 0; i < graph.arcs.size(); i++){
+		if(graph.arcs[i]->distance < 1){
+			FindShortestPath(graph, source, NULL, state);
+			return;
+		}
+		if(graph.arcs[i]->distance > longest) longest = graph.arcs[i]->distance;
+	}
+
+	deltaStateT run;
+	run.graph = &graph;
+	run.delta = delta;
+	run.label = vector<atomic<labelT> >(nodeCount);
+	for(int i = 0; i < nodeCount; i++)
+		run.label[i].store(UNREACHED_LABEL, memory_order_relaxed);
+	run.buckets.resize(longest / delta + 2);
+	run.lowered.resize(pool.threadCount());
+	run.scannedIn.assign(nodeCount, -1);
+	run.settledIn.assign(nodeCount, -1);
+	run.scans = 0;
+
+	run.label[source->id].store(MakeLabel(0, NO_ARC), memory_order_relaxed);
+	run.buckets[0].push_back(source->id);
+	run.pending = 1;
+
+	long long slots = run.buckets.size();
+	long long bucket = 0;
+	int step = 0;
+	vector<int> frontier, settled;
+	while(run.pending > 0){
+		while(run.buckets[bucket % slots].empty())
+			bucket++;
+		settled.clear();
+		// Light arcs, till no node falls back into this bucket
+		while(!run.buckets[bucket % slots].empty()){
+			vector<int> &entries = run.buckets[bucket % slots];
+			frontier.clear();
+			for(size_t i = 0; i < entries.size(); i++){
+				int node = entries[i];
+				if(LabelDistance(run.label[node].load(memory_order_relaxed)) / delta != bucket) continue;
+				if(run.scannedIn[node] == step) continue;
+				run.scannedIn[node] = step;
+				frontier.push_back(node);
+				if(run.settledIn[node] != bucket){
+					run.settledIn[node] = bucket;
+					settled.push_back(node);
+				}
+			}
+			run.pending -= entries.size();
+			entries.clear();
+			run.scans += frontier.size();
+			pool.parallelFor(frontier.size(), SCAN_CHUNK, [&](int i, int thread){
+				RelaxArcs(run, frontier[i], true, thread);
+			});
+			FileLoweredNodes(run);
+			step++;
+		}
+		// Heavy arcs, once from the final distances of the bucket
+		pool.parallelFor(settled.size(), SCAN_CHUNK, [&](int i, int thread){
+			RelaxArcs(run, settled[i], false, thread);
+		});
+		FileLoweredNodes(run);
+		bucket++;
+	}
+
+	InitSearchState(state, nodeCount);
+	for(int i = 0; i < nodeCount; i++){
+		labelT label = run.label[i].load(memory_order_relaxed);
+		if(label == UNREACHED_LABEL) continue;
+		state.dist[i] = LabelDistance(label);
+		state.touched.add(i);
+		unsigned int arcId = (unsigned int)(label & 0xFFFFFFFFu);
+		state.pred[i] = (arcId == NO_ARC) ? NULL : graph.arcs[arcId];
+	}
+	state.dequeues = run.scans;
+}
+
+/* Seconds spent growing the trees of all sources with numThreads threads, 0 for the sequential engine */
+static double TimeTrees(graphT &graph, Vector<nodeT *> &sources, int numThreads, Vector< Vector<int> > &dists,
+                        int &scans){
+	searchStateT state;
+	scans = 0;
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	if(numThreads == 0){
+		for(int i = 0; i < sources.size(); i++){
+			FindShortestPath(graph, sources[i], NULL, state);
+			dists[i] = state.dist;
+			scans += state.dequeues;
+		}
+	}
+	else{
+		WorkerPool pool(numThreads);
+		for(int i = 0; i < sources.size(); i++){
+			FindShortestPathTreeParallel(graph, sources[i], state, pool);
+			dists[i] = state.dist;
+			scans += state.dequeues;
+		}
+	}
+	return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+void BenchmarkDeltaStepping(graphT &graph, int maxThreads, int sourceCount){
+	int nodeCount = graph.nodeList.size();
+	if(nodeCount == 0) return;
+	if(sourceCount < 1) sourceCount = 1;
+	if(sourceCount > nodeCount) sourceCount = nodeCount;
+	if(maxThreads < 1) maxThreads = 1;
+	Vector<nodeT *> sources;
+	for(int i = 0; i < sourceCount; i++)
+		sources.add(graph.nodeList[(long long)i * nodeCount / sourceCount]);
+
+	Vector< Vector<int> > expected, dists;
+	for(int i = 0; i < sourceCount; i++){
+		expected.add(Vector<int>());
+		dists.add(Vector<int>());
+	}
+	int scans;
+	double sequential = TimeTrees(graph, sources, 0, expected, scans);
+	cout << "Delta-stepping on " << nodeCount << " nodes, " << sourceCount << " trees, delta "
+	     << ChooseDelta(graph) << endl;
+	cout << "Sequential: " << 1000 * sequential / sourceCount << " ms per tree, " << scans / sourceCount
+	     << " scans per tree" << endl;
+
+	double single = 0;
+	for(int threads = 1; ; threads = (threads * 2 < maxThreads) ? threads * 2 : maxThreads){
+		double seconds = TimeTrees(graph, sources, threads, dists, scans);
+		for(int i = 0; i < sourceCount; i++){
+			for(int j = 0; j < nodeCount; j++){
+				if(dists[i][j] != expected[i][j])
+					Error("BenchmarkDeltaStepping: wrong distance to " + graph.nodeList[j]->name);
+			}
+		}
+		if(threads == 1) single = seconds;
+		cout << threads << " threads: " << 1000 * seconds / sourceCount << " ms per tree, "
+		     << scans / sourceCount << " scans per tree, speedup " << (seconds > 0 ? single / seconds : 0)
+		     << " over 1 thread, " << (seconds > 0 ? sequential / seconds : 0) << " over sequential" << endl;
+		if(threads == maxThreads) break;
+	}
+}
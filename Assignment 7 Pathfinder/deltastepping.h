@@ -0,0 +1,54 @@
+/*
+ * File: deltastepping.h
+ * ---------------------
+ * This module exports a parallel engine for complete shortest path trees, based on delta-stepping (Meyer and
+ * Sanders). Tentative distances are kept in buckets of width delta. The nodes of the lowest non empty bucket are
+ * scanned together and in parallel: first their light arcs (distance <= delta), repeatedly, since those can put
+ * nodes back into the same bucket, and then once their heavy arcs, which can only reach later buckets. A small delta
+ * behaves like Dijkstra's algorithm with little parallel work per step; a large one like Bellman-Ford with much
+ * wasted work. The result is the same tree as FindShortestPath with a NULL target computes, whatever the number
+ * of threads.
+ */
+
+#ifndef _deltastepping_h
+#define _deltastepping_h
+
+#include "genlib.h"
+#include "pathgraph.h"
+#include "shortestpath.h"
+#include "parallel.h"
+
+/*
+ * Function: ChooseDelta
+ * Usage: int delta = ChooseDelta(graph);
+ * --------------------------------------
+ * Derives a bucket width from the arc distances of the graph: the larger of the mean arc distance divided by the
+ * mean number of arcs per node, and the smallest arc distance, but at least 1. Returns 0 if the graph has an arc
+ * with a distance below 1, for which delta-stepping is not used.
+ */
+int ChooseDelta(graphT &graph);
+
+/*
+ * Function: FindShortestPathTreeParallel
+ * Usage: FindShortestPathTreeParallel(graph, source, state, pool);
+ *        FindShortestPathTreeParallel(graph, source, state, pool, delta);
+ * -----------------------------------------------------------------------
+ * Fills state with the shortest path tree of source over the whole graph, using the threads of pool. delta is the
+ * bucket width, 0 to use ChooseDelta. Among several shortest paths to a node, its predecessor is the arc with the
+ * lowest id, so the tree does not depend on the order in which the threads work. state.dequeues counts the node
+ * scans, which exceeds the node count by the work repeated for nodes whose distance was lowered after their scan.
+ * Falls back to FindShortestPath if the graph has an arc with a distance below 1.
+ */
+void FindShortestPathTreeParallel(graphT &graph, nodeT *source, searchStateT &state, WorkerPool &pool, int delta = 0);
+
+/*
+ * Function: BenchmarkDeltaStepping
+ * Usage: BenchmarkDeltaStepping(graph, maxThreads, sourceCount);
+ * --------------------------------------------------------------
+ * Grows the complete trees of sourceCount sources spread evenly over the node ids, once with FindShortestPath and
+ * then with delta-stepping on 1, 2, 4, ... up to maxThreads threads, and prints the time per tree and the speedup
+ * of each run. Reports an error with Error if a delta-stepping tree differs in any distance.
+ */
+void BenchmarkDeltaStepping(graphT &graph, int maxThreads, int sourceCount);
+
+#endif
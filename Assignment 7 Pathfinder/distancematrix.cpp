@@ -0,0 +1,211 @@
+/*
+ * File: distancematrix.cpp
+ * ------------------------
+ * This file implements the many-to-many query, with one Dijkstra search per source or with the bucket algorithm on
+ * top of a contraction hierarchy.
+ */
+
+#include "distancematrix.h"
+#include "shortestpath.h"
+#include "contraction.h"
+#include "pqueue.h"
+
+/*
+ * Type: bucketEntryT
+ * ------------------
+ * A node reached by an upward search together with its distance. In a bucket, node is the index of the target whose
+ * search reached the node the bucket belongs to.
+ */
+struct bucketEntryT{
+	int node;
+	int key;
+};
+
+/* Function: CmpByBucketKey
+ * ------------------------
+ * Callback for the upward search queue. The entry with less key is given higher priority.
+ */
+int CmpByBucketKey(bucketEntryT entry1, bucketEntryT entry2){
+	if(entry1.key < entry2.key)
+		return 1;
+	else if(entry1.key == entry2.key)
+		return 0;
+	else
+		return -1;
+}
+
+/*
+ * Type: upwardScratchT
+ * --------------------
+ * Per thread scratch state of the upward searches, indexed by node id. Only the touched nodes are reset.
+ */
+struct upwardScratchT{
+	Vector<int> dist;
+	Vector<int> handle;
+	Vector<int> touched;
+	int dequeues;
+};
+
+/*
+ * Function: UpwardSearch
+ * ----------------------
+ * Runs Dijkstra's algorithm from node over the upward arcs of the hierarchy until the queue is empty, and lists
+ * every node it settles with its distance.
+ */
+static void UpwardSearch(contractionHierarchyT &ch, int node, upwardScratchT &scratch, Vector<bucketEntryT> &space){
+	if(scratch.dist.size() != ch.rank.size()){
+		for(int i = 0; i < ch.rank.size(); i++){
+			scratch.dist.add(INFINITE_DISTANCE);
+			scratch.handle.add(-1);
+		}
+	}
+	for(int i = 0; i < scratch.touched.size(); i++)
+		scratch.dist[scratch.touched[i]] = INFINITE_DISTANCE;
+	scratch.touched.clear();
+	IndexedPQueue<bucketEntryT> pq(CmpByBucketKey);
+	scratch.dist[node] = 0;
+	scratch.touched.add(node);
+	bucketEntryT first = {node, 0};
+	scratch.handle[node] = pq.enqueue(first);
+	while(!pq.isEmpty()){
+		bucketEntryT entry = pq.dequeueMax();
+		scratch.dequeues++;
+		space.add(entry);
+		Vector<chEdgeT> &edges = ch.up[entry.node];
+		for(int i = 0; i < edges.size(); i++){
+			chEdgeT edge = edges[i];
+			int newDistance = entry.key + edge.distance;
+			if(newDistance < scratch.dist[edge.node]){
+				bool queued = (scratch.dist[edge.node] != INFINITE_DISTANCE);
+				scratch.dist[edge.node] = newDistance;
+				bucketEntryT newEntry = {edge.node, newDistance};
+				if(queued)
+					pq.increaseKey(scratch.handle[edge.node], newEntry);
+				else{
+					scratch.touched.add(edge.node);
+					scratch.handle[edge.node] = pq.enqueue(newEntry);
+				}
+			}
+		}
+	}
+}
+
+/*
+ * Function: ComputeWithBuckets
+ * ----------------------------
+ * The bucket algorithm. The upward search from target j stores (j, distance) in the bucket of every node it settles.
+ * Each node on a shortest path from source to target through the highest node of the path is settled by both
+ * searches, so the distance from the ith source to the jth target is the minimum, over the nodes settled by the
+ * upward search from the source, of the source distance plus the target distance stored in the bucket.
+ */
+static void ComputeWithBuckets(contractionHierarchyT &ch, distanceMatrixT &matrix, int numThreads){
+	int targetCount = matrix.targets.size();
+	Vector<upwardScratchT> scratch;
+	for(int t = 0; t < numThreads; t++){
+		scratch.add(upwardScratchT());
+		scratch[t].dequeues = 0;
+	}
+
+	// Backward searches, one per target, then the buckets are filled in target order
+	Vector< Vector<bucketEntryT> > spaces;
+	for(int j = 0; j < targetCount; j++)
+		spaces.add(Vector<bucketEntryT>());
+	ParallelFor(targetCount, numThreads, [&](int j, int thread){
+		UpwardSearch(ch, matrix.targets[j]->id, scratch[thread], spaces[j]);
+	});
+	Vector< Vector<bucketEntryT> > buckets;
+	for(int i = 0; i < ch.rank.size(); i++)
+		buckets.add(Vector<bucketEntryT>());
+	for(int j = 0; j < targetCount; j++){
+		for(int k = 0; k < spaces[j].size(); k++){
+			bucketEntryT entry = {j, spaces[j][k].key};
+			buckets[spaces[j][k].node].add(entry);
+		}
+	}
+
+	// Forward searches, one per source, each filling its own row
+	ParallelFor(matrix.sources.size(), numThreads, [&](int i, int thread){
+		Vector<bucketEntryT> space;
+		UpwardSearch(ch, matrix.sources[i]->id, scratch[thread], space);
+		int row = i * targetCount;
+		for(int k = 0; k < space.size(); k++){
+			Vector<bucketEntryT> &bucket = buckets[space[k].node];
+			for(int b = 0; b < bucket.size(); b++){
+				int distance = space[k].key + bucket[b].key;
+				if(distance < matrix.dist[row + bucket[b].node])
+					matrix.dist[row + bucket[b].node] = distance;
+			}
+		}
+	});
+	for(int t = 0; t < numThreads; t++)
+		matrix.dequeues += scratch[t].dequeues;
+}
+
+/*
+ * Function: ComputeWithSearchTrees
+ * --------------------------------
+ * One Dijkstra search per source that stops once all targets are settled. The row and, if wanted, the paths are
+ * read off the search tree.
+ */
+static void ComputeWithSearchTrees(graphT &graph, distanceMatrixT &matrix, bool withPaths, int numThreads){
+	int targetCount = matrix.targets.size();
+	Vector<searchStateT> states;
+	Vector<int> dequeues;
+	for(int t = 0; t < numThreads; t++){
+		states.add(searchStateT());
+		dequeues.add(0);
+	}
+	ParallelFor(matrix.sources.size(), numThreads, [&](int i, int thread){
+		searchStateT &state = states[thread];
+		nodeT *source = matrix.sources[i];
+		FindShortestPathsToTargets(graph, source, matrix.targets, state);
+		dequeues[thread] += state.dequeues;
+		for(int j = 0; j < targetCount; j++){
+			nodeT *target = matrix.targets[j];
+			matrix.dist[i * targetCount + j] = state.dist[target->id];
+			if(withPaths)
+				matrix.paths[i * targetCount + j] = ExtractPath(state, source, target);
+		}
+	});
+	for(int t = 0; t < numThreads; t++)
+		matrix.dequeues += dequeues[t];
+}
+
+/* Looks up the nodes of the names and computes the matrix for them */
+void ComputeDistanceMatrix(graphT &graph, Vector<string> &sourceNames, Vector<string> &targetNames,
+                           distanceMatrixT &matrix, bool withPaths, int numThreads){
+	Vector<nodeT *> sources, targets;
+	for(int i = 0; i < sourceNames.size(); i++){
+		if(!graph.nodes.containsKey(sourceNames[i]))
+			Error("ComputeDistanceMatrix: unknown node " + sourceNames[i]);
+		sources.add(graph.nodes.getValue(sourceNames[i]));
+	}
+	for(int j = 0; j < targetNames.size(); j++){
+		if(!graph.nodes.containsKey(targetNames[j]))
+			Error("ComputeDistanceMatrix: unknown node " + targetNames[j]);
+		targets.add(graph.nodes.getValue(targetNames[j]));
+	}
+	ComputeDistanceMatrix(graph, sources, targets, matrix, withPaths, numThreads);
+}
+
+/* Sizes the matrix and picks the algorithm */
+void ComputeDistanceMatrix(graphT &graph, Vector<nodeT *> &sources, Vector<nodeT *> &targets,
+                           distanceMatrixT &matrix, bool withPaths, int numThreads){
+	if(graph.negativeArcs > 0)  // here rather than in the searches on the worker threads
+		Error("ComputeDistanceMatrix: negative arc distances are not supported");
+	if(numThreads < 1) numThreads = 1;
+	matrix.sources = sources;
+	matrix.targets = targets;
+	matrix.dist.clear();
+	matrix.paths.clear();
+	matrix.dequeues = 0;
+	for(int k = 0; k < sources.size() * targets.size(); k++){
+		matrix.dist.add(INFINITE_DISTANCE);
+		if(withPaths)
+			matrix.paths.add(Stack<arcT *>());
+	}
+	if(graph.hierarchy != NULL && !withPaths)
+		ComputeWithBuckets(*graph.hierarchy, matrix, numThreads);
+	else
+		ComputeWithSearchTrees(graph, matrix, withPaths, numThreads);
+}
@@ -0,0 +1,50 @@
+/*
+ * File: distancematrix.h
+ * ----------------------
+ * This module exports the many-to-many query: the shortest distances from every node of a source list to every node
+ * of a target list, as needed for origin-destination matrices. Instead of one query per pair, work is shared across
+ * each row. Without a hierarchy, one Dijkstra search per source settles all targets at once. With a contraction
+ * hierarchy, each target leaves its upward search space in buckets, and one upward search per source then reads the
+ * distances to all targets out of the buckets it passes. The sources are spread over several threads.
+ */
+
+#ifndef _distancematrix_h
+#define _distancematrix_h
+
+#include "genlib.h"
+#include "vector.h"
+#include "stack.h"
+#include "pathgraph.h"
+#include "parallel.h"
+
+/*
+ * Type: distanceMatrixT
+ * ---------------------
+ * The result of a many-to-many query. Entry (i, j) belongs to the ith source and the jth target and is stored at
+ * index i * targets.size() + j.
+ */
+struct distanceMatrixT{
+	Vector<nodeT *> sources;
+	Vector<nodeT *> targets;
+	Vector<int> dist;             // shortest distance of each pair, INFINITE_DISTANCE if the target cannot be reached
+	Vector< Stack<arcT *> > paths;  // path of each pair in the order of ExtractPath, only if paths were requested
+	int dequeues;                 // entries removed from the priority queues by all searches together
+};
+
+/*
+ * Function: ComputeDistanceMatrix
+ * Usage: ComputeDistanceMatrix(graph, sourceNames, targetNames, matrix);
+ *        ComputeDistanceMatrix(graph, sources, targets, matrix, true, numThreads);
+ * ------------------------------------------------------------------------------
+ * Fills matrix with the distances from every source to every target. The sources and targets are given by node
+ * name or by node, and the name version reports an unknown name with Error. If withPaths is true the paths are
+ * stored as well; they come from the search trees, so this always uses one Dijkstra search per source. Otherwise
+ * the bucket algorithm is used if graph.hierarchy has been loaded or built. Work is spread over numThreads threads;
+ * the result does not depend on their number. Reports an error with Error if the graph has a negative arc.
+ */
+void ComputeDistanceMatrix(graphT &graph, Vector<string> &sourceNames, Vector<string> &targetNames,
+                           distanceMatrixT &matrix, bool withPaths = false, int numThreads = DefaultThreadCount());
+void ComputeDistanceMatrix(graphT &graph, Vector<nodeT *> &sources, Vector<nodeT *> &targets,
+                           distanceMatrixT &matrix, bool withPaths = false, int numThreads = DefaultThreadCount());
+
+#endif
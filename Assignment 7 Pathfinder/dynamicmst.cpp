@@ -0,0 +1,313 @@
+/*
+ * File: dynamicmst.cpp
+ * --------------------
+ * This file implements the link-cut tree and the updates of the dynamic minimal spanning forest.
+ */
+
+#include <climits>
+#include "dynamicmst.h"
+
+/*
+ * The order of an arc packed into one key: distance in the high half, shifted to be non negative, and id in the low
+ * half, plus one to keep 0 for the node vertices.
+ */
+static inline unsigned long long ArcOrderKey(arcT *arc){
+	return (((unsigned long long)((long long)arc->distance - INT_MIN) << 32) | (unsigned int)arc->id) + 1;
+}
+
+/* Adds a vertex of the given key to the forest and returns its index */
+static int NewVertex(dynamicSpanningTreeT &mst, unsigned long long key){
+	linkCutVertexT vertex = {{-1, -1}, -1, false, key, -1};
+	mst.forest.push_back(vertex);
+	int index = mst.forest.size() - 1;
+	if(key != 0) mst.forest[index].longest = index;
+	return index;
+}
+
+/* True if x is the root of its splay tree */
+static inline bool IsSplayRoot(vector<linkCutVertexT> &forest, int x){
+	int parent = forest[x].parent;
+	return parent < 0 || (forest[parent].child[0] != x && forest[parent].child[1] != x);
+}
+
+/* The longer of the arcs of two vertices, either of which may be -1 */
+static inline int Longer(vector<linkCutVertexT> &forest, int a, int b){
+	if(a < 0) return b;
+	if(b < 0) return a;
+	return (forest[a].key > forest[b].key) ? a : b;
+}
+
+/* Recomputes the longest arc of the splay subtree of x from its children */
+static inline void Update(vector<linkCutVertexT> &forest, int x){
+	int longest = (forest[x].key != 0) ? x : -1;
+	for(int side = 0; side < 2; side++){
+		int child = forest[x].child[side];
+		if(child >= 0) longest = Longer(forest, longest, forest[child].longest);
+	}
+	forest[x].longest = longest;
+}
+
+/* Carries out a pending reversal of the path below x by one level */
+static inline void Push(vector<linkCutVertexT> &forest, int x){
+	if(!forest[x].flip) return;
+	swap(forest[x].child[0], forest[x].child[1]);
+	for(int side = 0; side < 2; side++){
+		int child = forest[x].child[side];
+		if(child >= 0) forest[child].flip = !forest[child].flip;
+	}
+	forest[x].flip = false;
+}
+
+static void Rotate(vector<linkCutVertexT> &forest, int x){
+	int parent = forest[x].parent;
+	int grandparent = forest[parent].parent;
+	int side = (forest[parent].child[1] == x) ? 1 : 0;
+	if(!IsSplayRoot(forest, parent)){
+		if(forest[grandparent].child[0] == parent)
+			forest[grandparent].child[0] = x;
+		else
+			forest[grandparent].child[1] = x;
+	}
+	forest[x].parent = grandparent;
+	int moved = forest[x].child[1 - side];
+	forest[parent].child[side] = moved;
+	if(moved >= 0) forest[moved].parent = parent;
+	forest[x].child[1 - side] = parent;
+	forest[parent].parent = x;
+	Update(forest, parent);
+	Update(forest, x);
+}
+
+/* Makes x the root of its splay tree, pushing pending reversals down from the root first */
+static void Splay(vector<linkCutVertexT> &forest, int x){
+	static thread_local vector<int> above;  // x and its splay tree ancestors
+	above.clear();
+	for(int y = x; ; y = forest[y].parent){
+		above.push_back(y);
+		if(IsSplayRoot(forest, y)) break;
+	}
+	for(int i = above.size() - 1; i >= 0; i--)
+		Push(forest, above[i]);
+	while(!IsSplayRoot(forest, x)){
+		int parent = forest[x].parent;
+		if(!IsSplayRoot(forest, parent)){
+			int grandparent = forest[parent].parent;
+			bool zigZig = (forest[grandparent].child[0] == parent) == (forest[parent].child[0] == x);
+			Rotate(forest, zigZig ? parent : x);
+		}
+		Rotate(forest, x);
+	}
+}
+
+/* Makes the path from the root of the tree to x preferred and x the root of its splay tree */
+static void Access(vector<linkCutVertexT> &forest, int x){
+	int last = -1;
+	for(int y = x; y >= 0; y = forest[y].parent){
+		Splay(forest, y);
+		forest[y].child[1] = last;
+		Update(forest, y);
+		last = y;
+	}
+	Splay(forest, x);
+}
+
+/* Makes x the root of its tree */
+static void MakeRoot(vector<linkCutVertexT> &forest, int x){
+	Access(forest, x);
+	forest[x].flip = !forest[x].flip;
+}
+
+static int FindRoot(vector<linkCutVertexT> &forest, int x){
+	Access(forest, x);
+	while(true){
+		Push(forest, x);
+		if(forest[x].child[0] < 0) break;
+		x = forest[x].child[0];
+	}
+	Splay(forest, x);
+	return x;
+}
+
+/* Joins the trees of x and y, which must differ, by an edge between them */
+static void Link(vector<linkCutVertexT> &forest, int x, int y){
+	MakeRoot(forest, x);
+	forest[x].parent = y;
+}
+
+/* Removes the edge between x and y */
+static void Cut(vector<linkCutVertexT> &forest, int x, int y){
+	MakeRoot(forest, x);
+	Access(forest, y);
+	forest[y].child[0] = -1;
+	forest[x].parent = -1;
+	Update(forest, y);
+}
+
+/* The vertex of the longest arc on the path between x and y, which must be connected */
+static int LongestOnPath(vector<linkCutVertexT> &forest, int x, int y){
+	MakeRoot(forest, x);
+	Access(forest, y);
+	return forest[y].longest;
+}
+
+/* Extends the arrays to nodes and arcs added to the graph since the last update */
+static void CatchUpWithGraph(dynamicSpanningTreeT &mst){
+	graphT &graph = *mst.graph;
+	while((int)mst.nodeVertex.size() < graph.nodeList.size()){
+		mst.nodeVertex.push_back(NewVertex(mst, 0));
+		mst.visitMark.push_back(0);
+		mst.components++;
+	}
+	while((int)mst.arcVertex.size() < graph.arcs.size()){
+		mst.arcVertex.push_back(-1);
+		mst.arcState.push_back(ABSENT_ARC);
+		mst.treePosition.push_back(-1);
+	}
+}
+
+/* Puts arc into the forest, between two trees */
+static void LinkArc(dynamicSpanningTreeT &mst, arcT *arc){
+	int &vertex = mst.arcVertex[arc->id];
+	if(vertex < 0) vertex = NewVertex(mst, ArcOrderKey(arc));
+	mst.forest[vertex].key = ArcOrderKey(arc);
+	Update(mst.forest, vertex);
+	Link(mst.forest, mst.nodeVertex[arc->start->id], vertex);
+	Link(mst.forest, vertex, mst.nodeVertex[arc->end->id]);
+	mst.arcState[arc->id] = TREE_ARC;
+	mst.treePosition[arc->id] = mst.treeArcs.size();
+	mst.treeArcs.push_back(arc->id);
+	mst.distance += arc->distance;
+	mst.components--;
+}
+
+/* Takes a tree arc out of the forest and leaves it in the given state */
+static void CutArc(dynamicSpanningTreeT &mst, arcT *arc, char state){
+	int vertex = mst.arcVertex[arc->id];
+	Cut(mst.forest, mst.nodeVertex[arc->start->id], vertex);
+	Cut(mst.forest, vertex, mst.nodeVertex[arc->end->id]);
+	int position = mst.treePosition[arc->id];
+	int last = mst.treeArcs.back();
+	mst.treeArcs[position] = last;
+	mst.treePosition[last] = position;
+	mst.treeArcs.pop_back();
+	mst.treePosition[arc->id] = -1;
+	mst.arcState[arc->id] = state;
+	mst.distance -= arc->distance;
+	mst.components++;
+}
+
+void InitDynamicSpanningTree(graphT &graph, dynamicSpanningTreeT &mst){
+	mst.graph = &graph;
+	mst.forest.clear();
+	mst.nodeVertex.clear();
+	mst.arcVertex.clear();
+	mst.arcState.clear();
+	mst.treeArcs.clear();
+	mst.treePosition.clear();
+	mst.visitMark.clear();
+	mst.visitStamp = 0;
+	mst.distance = 0;
+	mst.components = 0;
+	mst.scannedNodes = 0;
+	CatchUpWithGraph(mst);
+	for(int i = 0; i < graph.arcs.size(); i++)
+		mst.arcState[i] = OTHER_ARC;
+	spanningTreeT tree;
+	KruskalSpanningTree(graph, tree);
+	for(int i = 0; i < tree.arcs.size(); i++)
+		LinkArc(mst, tree.arcs[i]);
+}
+
+void InsertSpanningArc(dynamicSpanningTreeT &mst, arcT *arc){
+	CatchUpWithGraph(mst);
+	if(mst.arcState[arc->id] != ABSENT_ARC) Error("InsertSpanningArc: the arc is already present");
+	mst.arcState[arc->id] = OTHER_ARC;
+	if(arc->start == arc->end) return;
+	vector<linkCutVertexT> &forest = mst.forest;
+	int start = mst.nodeVertex[arc->start->id], end = mst.nodeVertex[arc->end->id];
+	if(FindRoot(forest, start) != FindRoot(forest, end)){
+		LinkArc(mst, arc);
+		return;
+	}
+	// The arc closes a cycle: it replaces the longest arc on the cycle if it is shorter
+	int longest = LongestOnPath(forest, start, end);
+	if(forest[longest].key < ArcOrderKey(arc)) return;
+	int longestId = (int)((forest[longest].key - 1) & 0xFFFFFFFFu);
+	CutArc(mst, mst.graph->arcs[longestId], OTHER_ARC);
+	LinkArc(mst, arc);
+}
+
+/*
+ * Finds the shortest arc outside the forest between the tree of start and the tree of end, which were split by the
+ * last cut, or NULL if there is none. Both trees are walked one node at a time in turn; when one is exhausted, it is
+ * the smaller one, and the arcs leaving it are the candidates.
+ */
+static arcT *FindReplacement(dynamicSpanningTreeT &mst, nodeT *start, nodeT *end){
+	mst.visitStamp += 2;
+	int marks[2] = {mst.visitStamp, mst.visitStamp + 1};
+	vector<nodeT *> visited[2];
+	int next[2] = {0, 0};
+	visited[0].push_back(start);
+	visited[1].push_back(end);
+	mst.visitMark[start->id] = marks[0];
+	mst.visitMark[end->id] = marks[1];
+	int smaller = -1;
+	while(smaller < 0){
+		for(int side = 0; side < 2 && smaller < 0; side++){
+			if(next[side] == (int)visited[side].size()){
+				smaller = side;
+				break;
+			}
+			nodeT *node = visited[side][next[side]++];
+			for(int i = 0; i < node->arcs.size(); i++){
+				arcT *arc = node->arcs[i];
+				if(mst.arcState[arc->id] != TREE_ARC) continue;
+				nodeT *other = OtherEnd(arc, node);
+				if(mst.visitMark[other->id] == marks[side]) continue;
+				mst.visitMark[other->id] = marks[side];
+				visited[side].push_back(other);
+			}
+		}
+	}
+	mst.scannedNodes = visited[0].size() + visited[1].size();
+	arcT *best = NULL;
+	for(size_t n = 0; n < visited[smaller].size(); n++){
+		nodeT *node = visited[smaller][n];
+		for(int i = 0; i < node->arcs.size(); i++){
+			arcT *arc = node->arcs[i];
+			if(mst.arcState[arc->id] != OTHER_ARC) continue;
+			if(mst.visitMark[OtherEnd(arc, node)->id] == marks[smaller]) continue;
+			if(best == NULL || ArcOrderKey(arc) < ArcOrderKey(best)) best = arc;
+		}
+	}
+	return best;
+}
+
+void DeleteSpanningArc(dynamicSpanningTreeT &mst, arcT *arc){
+	CatchUpWithGraph(mst);
+	char state = mst.arcState[arc->id];
+	if(state == ABSENT_ARC) Error("DeleteSpanningArc: the arc is not present");
+	mst.scannedNodes = 0;
+	if(state == OTHER_ARC){
+		mst.arcState[arc->id] = ABSENT_ARC;
+		return;
+	}
+	CutArc(mst, arc, ABSENT_ARC);
+	arcT *replacement = FindReplacement(mst, arc->start, arc->end);
+	if(replacement != NULL) LinkArc(mst, replacement);
+}
+
+void UpdateSpanningArcDistance(dynamicSpanningTreeT &mst, arcT *arc, int distance){
+	DeleteSpanningArc(mst, arc);
+	UpdateArcDistance(*mst.graph, arc, distance);
+	InsertSpanningArc(mst, arc);
+}
+
+void GetSpanningTree(dynamicSpanningTreeT &mst, spanningTreeT &tree){
+	CatchUpWithGraph(mst);
+	tree.arcs.clear();
+	for(size_t i = 0; i < mst.treeArcs.size(); i++)
+		tree.arcs.add(mst.graph->arcs[mst.treeArcs[i]]);
+	tree.distance = mst.distance;
+	tree.components = mst.components;
+}
@@ -0,0 +1,112 @@
+/*
+ * File: dynamicmst.h
+ * ------------------
+ * This module exports a minimal spanning forest that is kept up to date while arcs come and go, so that adding a
+ * road does not mean running a spanning tree engine over the whole graph again.
+ *
+ * The forest is held in a link-cut tree (Sleator and Tarjan), in which each tree arc is a vertex of its own between
+ * its two end points. The link-cut tree can tell whether two nodes are connected and find the longest arc on the
+ * tree path between them, both in O(log V) amortized time. An inserted arc that joins two trees is linked; one that
+ * closes a cycle replaces the longest arc on the cycle if it is shorter. A deleted tree arc splits its tree in two;
+ * the replacement is the shortest remaining arc between the halves, found by walking both halves at the same pace
+ * and scanning the arcs of the half that runs out first.
+ *
+ * Arcs are ordered by distance and then by id, as in the other engines, so the forest is always the one
+ * KruskalSpanningTree would compute from the arcs present.
+ */
+
+#ifndef _dynamicmst_h
+#define _dynamicmst_h
+
+#include <vector>
+#include "genlib.h"
+#include "pathgraph.h"
+#include "mst.h"
+
+/*
+ * Type: linkCutVertexT
+ * --------------------
+ * A vertex of the link-cut tree: a node of the graph, or an arc of the forest. Each preferred path is a splay tree
+ * in path order; the parent link of a splay tree root points to the vertex the path hangs from.
+ */
+struct linkCutVertexT{
+	int child[2];              // splay tree children, -1 for none
+	int parent;                // splay tree parent or path parent, -1 for none
+	bool flip;                 // the path below is to be reversed, pushed down lazily
+	unsigned long long key;    // order of the arc, 0 for node vertices
+	int longest;               // vertex of the longest arc in the splay subtree, -1 if there is none
+};
+
+/*
+ * Type: dynamicSpanningTreeT
+ * --------------------------
+ * The minimal spanning forest of the arcs present. All arcs of the graph are present after
+ * InitDynamicSpanningTree; arcs added to the graph later join with InsertSpanningArc, and DeleteSpanningArc takes
+ * an arc out without removing it from the graph.
+ */
+struct dynamicSpanningTreeT{
+	graphT *graph;
+	vector<linkCutVertexT> forest;
+	vector<int> nodeVertex;    // node id -> its vertex in forest
+	vector<int> arcVertex;     // arc id -> its vertex in forest, -1 if it has none yet
+	vector<char> arcState;     // arc id -> ABSENT_ARC, TREE_ARC or OTHER_ARC
+	vector<int> treeArcs;      // ids of the tree arcs, in no particular order
+	vector<int> treePosition;  // arc id -> index in treeArcs
+	vector<int> visitMark;     // node id -> mark of the last replacement search that reached it
+	int visitStamp;
+	long long distance;        // sum of the distances of the tree arcs
+	int components;            // number of trees, counting nodes without arcs
+	int scannedNodes;          // nodes visited by the replacement search of the last deletion
+};
+
+/* States of an arc */
+const char ABSENT_ARC = 0;
+const char TREE_ARC = 1;
+const char OTHER_ARC = 2;
+
+/*
+ * Function: InitDynamicSpanningTree
+ * Usage: InitDynamicSpanningTree(graph, mst);
+ * -------------------------------------------
+ * Builds the forest of all arcs of the graph with KruskalSpanningTree and links it into the link-cut tree.
+ */
+void InitDynamicSpanningTree(graphT &graph, dynamicSpanningTreeT &mst);
+
+/*
+ * Function: InsertSpanningArc
+ * Usage: InsertSpanningArc(mst, AddArc(graph, start, end, distance));
+ * -------------------------------------------------------------------
+ * Adds an arc of the graph to the arcs present and updates the forest in O(log V) amortized time. Nodes added to
+ * the graph since the last update join as trees of their own. Reports an error if the arc is already present.
+ */
+void InsertSpanningArc(dynamicSpanningTreeT &mst, arcT *arc);
+
+/*
+ * Function: DeleteSpanningArc
+ * Usage: DeleteSpanningArc(mst, arc);
+ * -----------------------------------
+ * Takes an arc out of the arcs present; the graph itself keeps it. Deleting an arc outside the forest costs O(1).
+ * Deleting a tree arc costs O(log V) amortized plus a search for its replacement, which visits twice the nodes of
+ * the smaller half of the split tree and scans their arcs. Reports an error if the arc is not present.
+ */
+void DeleteSpanningArc(dynamicSpanningTreeT &mst, arcT *arc);
+
+/*
+ * Function: UpdateSpanningArcDistance
+ * Usage: UpdateSpanningArcDistance(mst, arc, distance);
+ * -----------------------------------------------------
+ * Changes the distance of a present arc with UpdateArcDistance and updates the forest, as a deletion followed by an
+ * insertion. Arc distances must not be changed any other way while the arc is present.
+ */
+void UpdateSpanningArcDistance(dynamicSpanningTreeT &mst, arcT *arc, int distance);
+
+/*
+ * Function: GetSpanningTree
+ * Usage: GetSpanningTree(mst, tree);
+ * ----------------------------------
+ * Fills tree with the current forest in O(V) time, its arcs in no particular order. Nodes added to the graph since
+ * the last update count as trees of their own.
+ */
+void GetSpanningTree(dynamicSpanningTreeT &mst, spanningTreeT &tree);
+
+#endif
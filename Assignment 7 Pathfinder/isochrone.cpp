@@ -0,0 +1,56 @@
+/*
+ * File: isochrone.cpp
+ * -------------------
+ * This file implements the range queries on top of the bounded search. The touched list of the search holds every
+ * node it reached; those within the budget are settled and final, the others lie just beyond the budget and are
+ * skipped. Walking the touched list rather than all node ids keeps the cost at what the search settled.
+ */
+
+#include "isochrone.h"
+
+int FindNodesWithinDistance(graphT &graph, nodeT *source, int budget, searchStateT &state,
+                            Vector<reachedNodeT> &reached){
+	reached.clear();
+	FindShortestPathWithin(graph, source, budget, state);
+	for(int i = 0; i < state.touched.size(); i++){
+		int id = state.touched[i];
+		if(state.dist[id] > budget) continue;  // only reached, its distance is tentative
+		reachedNodeT entry = {graph.nodeList[id], state.dist[id]};
+		reached.add(entry);
+	}
+	return reached.size();
+}
+
+/* Index of the first limit at or above distance, by binary search */
+static int FindBand(Vector<int> &limits, int distance){
+	int low = 0, high = limits.size() - 1;
+	while(low < high){
+		int middle = (low + high) / 2;
+		if(limits[middle] < distance)
+			low = middle + 1;
+		else
+			high = middle;
+	}
+	return low;
+}
+
+void FindIsochroneBands(graphT &graph, nodeT *source, Vector<int> &limits, searchStateT &state,
+                        Vector< Vector<reachedNodeT> > &bands){
+	for(int i = 1; i < limits.size(); i++){
+		if(limits[i] <= limits[i - 1])
+			Error("FindIsochroneBands: limits must be strictly ascending");
+	}
+	bands.clear();
+	for(int i = 0; i < limits.size(); i++)
+		bands.add(Vector<reachedNodeT>());
+	if(limits.size() == 0) return;
+	int budget = limits[limits.size() - 1];
+	FindShortestPathWithin(graph, source, budget, state);
+	for(int i = 0; i < state.touched.size(); i++){
+		int id = state.touched[i];
+		int distance = state.dist[id];
+		if(distance > budget) continue;  // only reached, its distance is tentative
+		reachedNodeT entry = {graph.nodeList[id], distance};
+		bands[FindBand(limits, distance)].add(entry);
+	}
+}
@@ -0,0 +1,51 @@
+/*
+ * File: isochrone.h
+ * -----------------
+ * This module exports the range query used for service areas: every node within a distance budget of a source,
+ * with its distance, optionally split into nested bands (for example everything within 5, 10 and 15 minutes) by a
+ * single search. The search stops at the first node beyond the budget, and since the search state only resets the
+ * nodes the previous search touched, a query costs what it settles rather than the size of the graph.
+ */
+
+#ifndef _isochrone_h
+#define _isochrone_h
+
+#include "genlib.h"
+#include "vector.h"
+#include "pathgraph.h"
+#include "shortestpath.h"
+
+/*
+ * Type: reachedNodeT
+ * ------------------
+ * A node within the budget and its shortest distance from the source.
+ */
+struct reachedNodeT{
+	nodeT *node;
+	int distance;
+};
+
+/*
+ * Function: FindNodesWithinDistance
+ * Usage: int count = FindNodesWithinDistance(graph, source, budget, state, reached);
+ * ---------------------------------------------------------------------------------
+ * Fills reached with every node whose shortest distance from source is at most budget, source included, in the
+ * order the search first reached them. state is the scratch state of the search and also keeps the predecessors,
+ * so ExtractPath gives the path to any reached node. Returns the number of nodes reached.
+ */
+int FindNodesWithinDistance(graphT &graph, nodeT *source, int budget, searchStateT &state,
+                            Vector<reachedNodeT> &reached);
+
+/*
+ * Function: FindIsochroneBands
+ * Usage: FindIsochroneBands(graph, source, limits, state, bands);
+ * ---------------------------------------------------------------
+ * Splits the nodes within the largest of limits into bands with one search. limits must be strictly ascending;
+ * band i holds the nodes whose distance is greater than limits[i - 1] and at most limits[i], in the order the search
+ * first reached them, so the nodes within limits[i] are those of bands 0 to i. Reports an error with Error if limits
+ * is not ascending.
+ */
+void FindIsochroneBands(graphT &graph, nodeT *source, Vector<int> &limits, searchStateT &state,
+                        Vector< Vector<reachedNodeT> > &bands);
+
+#endif
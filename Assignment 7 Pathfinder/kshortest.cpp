@@ -0,0 +1,178 @@
+/*
+ * File: kshortest.cpp
+ * -------------------
+ * This file implements Yen's algorithm. Two things keep the spur searches cheap. The node and arc bans are stamps
+ * in arrays shared by all spur searches, and the search state only resets the nodes the previous search reached, so
+ * a spur search costs what it explores rather than the size of the graph. And walking the spur node along a path,
+ * the root path bans and the list of earlier paths sharing the root are extended by one node per step instead of
+ * being rebuilt. Spur nodes before the point where a path left its parent are skipped (Lawler's refinement): their
+ * detours were already offered when the parent was expanded.
+ */
+
+#include "kshortest.h"
+#include "pqueue.h"
+#include "set.h"
+#include "strutils.h"
+
+/*
+ * Type: yenPathT
+ * --------------
+ * A found or candidate path, kept in walking order.
+ */
+struct yenPathT{
+	Vector<arcT *> arcs;    // arcs from source to target
+	Vector<nodeT *> nodes;  // nodes from source to target, one more than arcs
+	Vector<int> prefix;     // distance from source to each node of nodes
+	int deviation;          // index of the spur node at which the path left the path it was derived from
+};
+
+/*
+ * Type: candidateT
+ * ----------------
+ * An entry of the candidate queue, referring to a path in the candidate list.
+ */
+struct candidateT{
+	int distance;
+	int arcCount;
+	int index;     // index in the candidate list
+};
+
+/* Function: CmpCandidates
+ * -----------------------
+ * This function is the callback function for the candidate queue. The shorter path is given higher priority, and
+ * of two equally long paths the one with fewer arcs.
+ */
+int CmpCandidates(candidateT candidate1, candidateT candidate2){
+	if(candidate1.distance != candidate2.distance)
+		return (candidate1.distance < candidate2.distance) ? 1 : -1;
+	if(candidate1.arcCount != candidate2.arcCount)
+		return (candidate1.arcCount < candidate2.arcCount) ? 1 : -1;
+	return 0;
+}
+
+/* Appends arc to the end of path */
+static void Extend(yenPathT &path, arcT *arc){
+	nodeT *last = path.nodes[path.nodes.size() - 1];
+	path.arcs.add(arc);
+	path.nodes.add(OtherEnd(arc, last));
+	path.prefix.add(path.prefix[path.prefix.size() - 1] + arc->distance);
+}
+
+/* The first spurIndex arcs of root, followed by the path the last search found from the spur node to target */
+static yenPathT JoinSpurPath(yenPathT &root, int spurIndex, searchStateT &search, nodeT *target){
+	yenPathT path;
+	path.nodes.add(root.nodes[0]);
+	path.prefix.add(0);
+	path.deviation = spurIndex;
+	for(int i = 0; i < spurIndex; i++)
+		Extend(path, root.arcs[i]);
+	Stack<arcT *> spurPath = ExtractPath(search, root.nodes[spurIndex], target);  // arc touching target on top
+	Vector<arcT *> reversed;
+	while(!spurPath.isEmpty())
+		reversed.add(spurPath.pop());
+	for(int i = reversed.size() - 1; i >= 0; i--)
+		Extend(path, reversed[i]);
+	return path;
+}
+
+/* The A* heuristic of the spur searches: the exact distance to the target without bans */
+static int DistanceToTarget(nodeT *node, nodeT */*target*/, void *clientData){
+	searchStateT *toTarget = (searchStateT *)clientData;
+	int distance = toTarget->dist[node->id];
+	return (distance == INFINITE_DISTANCE) ? 0 : distance;  // only nodes cut off from the target, never reached
+}
+
+/* A string that identifies the path, to recognise a candidate offered twice */
+static string PathKey(yenPathT &path){
+	string key;
+	for(int i = 0; i < path.arcs.size(); i++)
+		key += IntegerToString(path.arcs[i]->id) + " ";
+	return key;
+}
+
+/* Offers the path as a candidate unless it was offered before */
+static void AddCandidate(yenPathT &path, Vector<yenPathT> &pool, PQueue<candidateT> &candidates, Set<string> &seen){
+	string key = PathKey(path);
+	if(seen.contains(key)) return;
+	seen.add(key);
+	candidateT candidate = {path.prefix[path.prefix.size() - 1], path.arcs.size(), pool.size()};
+	pool.add(path);
+	candidates.enqueue(candidate);
+}
+
+/* Runs the spur searches of the last found path and offers their paths as candidates */
+static void ExpandPath(graphT &graph, Vector<yenPathT> &found, nodeT *target, kShortestStateT &state,
+                       Vector<yenPathT> &pool, PQueue<candidateT> &candidates, Set<string> &seen){
+	yenPathT &last = found[found.size() - 1];
+	InitSearchBan(state.ban, graph);
+	Vector<int> sharing;  // found paths that follow last up to the current spur node
+	for(int j = 0; j < found.size(); j++)
+		sharing.add(j);
+	for(int i = 0; i + 1 < last.nodes.size(); i++){
+		if(i > 0){
+			// The spur node moves one arc along: the previous one joins the root path
+			state.ban.node[last.nodes[i - 1]->id] = state.ban.nodeMark;
+			Vector<int> stillSharing;
+			for(int j = 0; j < sharing.size(); j++){
+				if(found[sharing[j]].arcs[i - 1] == last.arcs[i - 1])
+					stillSharing.add(sharing[j]);
+			}
+			sharing = stillSharing;
+		}
+		if(i < last.deviation) continue;
+		state.ban.arcMark++;
+		for(int j = 0; j < sharing.size(); j++)
+			state.ban.arc[found[sharing[j]].arcs[i]->id] = state.ban.arcMark;
+		nodeT *spur = last.nodes[i];
+		state.spurSearches++;
+		bool reached = FindShortestPathAvoiding(graph, spur, target, state.search, state.ban, DistanceToTarget,
+		                                        &state.toTarget);
+		state.dequeues += state.search.dequeues;
+		if(!reached) continue;
+		yenPathT path = JoinSpurPath(last, i, state.search, target);
+		AddCandidate(path, pool, candidates, seen);
+	}
+}
+
+int FindKShortestPaths(graphT &graph, nodeT *source, nodeT *target, int k, Vector<rankedPathT> &paths,
+                       kShortestStateT &state){
+	paths.clear();
+	state.dequeues = state.spurSearches = 0;
+	if(k < 1) return 0;
+	if(source == target){
+		rankedPathT only;
+		only.distance = 0;
+		paths.add(only);
+		return 1;
+	}
+	FindShortestPath(graph, target, NULL, state.toTarget);  // arcs are bidirectional: distances to the target
+	state.dequeues += state.toTarget.dequeues;
+	if(state.toTarget.dist[source->id] == INFINITE_DISTANCE) return 0;
+	yenPathT shortest;  // follows the predecessors of the search from the target, which lead from source to target
+	shortest.nodes.add(source);
+	shortest.prefix.add(0);
+	shortest.deviation = 0;
+	while(shortest.nodes[shortest.nodes.size() - 1] != target)
+		Extend(shortest, state.toTarget.pred[shortest.nodes[shortest.nodes.size() - 1]->id]);
+	Vector<yenPathT> found;
+	found.add(shortest);
+
+	Vector<yenPathT> pool;  // every candidate ever offered, referred to by the queue entries
+	PQueue<candidateT> candidates(CmpCandidates);
+	Set<string> seen;
+	seen.add(PathKey(found[0]));
+	while(found.size() < k){
+		ExpandPath(graph, found, target, state, pool, candidates, seen);
+		if(candidates.isEmpty()) break;
+		found.add(pool[candidates.dequeueMax().index]);
+	}
+
+	for(int i = 0; i < found.size(); i++){
+		rankedPathT ranked;
+		for(int j = 0; j < found[i].arcs.size(); j++)
+			ranked.path.push(found[i].arcs[j]);
+		ranked.distance = found[i].prefix[found[i].prefix.size() - 1];
+		paths.add(ranked);
+	}
+	return found.size();
+}
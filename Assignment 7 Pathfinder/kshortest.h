@@ -0,0 +1,56 @@
+/*
+ * File: kshortest.h
+ * -----------------
+ * This module exports the k shortest loopless paths query (Yen's algorithm), which offers alternative routes next to
+ * the shortest one. Each path found after the first is a detour of an earlier path: it follows that path up to some
+ * spur node (the root path) and then takes the shortest way to the target that avoids the root path nodes and
+ * every arc by which an earlier path with the same root leaves the spur node. The spur searches are A* searches
+ * guided by the exact distances to the target, which one complete search from the target provides up front; bans
+ * only make paths longer, so these distances stay a consistent lower bound.
+ */
+
+#ifndef _kshortest_h
+#define _kshortest_h
+
+#include "genlib.h"
+#include "vector.h"
+#include "stack.h"
+#include "pathgraph.h"
+#include "shortestpath.h"
+
+/*
+ * Type: rankedPathT
+ * -----------------
+ * One of the k shortest paths.
+ */
+struct rankedPathT{
+	Stack<arcT *> path;  // arcs in the order of ExtractPath, the arc touching the target on top
+	int distance;        // total distance of the path
+};
+
+/*
+ * Type: kShortestStateT
+ * ---------------------
+ * The scratch state of the spur searches. All spur searches of a query share it, and it can be reused for any
+ * number of queries on the same graph.
+ */
+struct kShortestStateT{
+	searchStateT toTarget;  // complete search from the target, without bans
+	searchStateT search;    // distances and predecessors of the current spur search
+	searchBanT ban;         // root path nodes and used spur arcs
+	int dequeues;           // entries removed from the priority queues by all searches of the last query
+	int spurSearches;       // number of spur searches run by the last query
+};
+
+/*
+ * Function: FindKShortestPaths
+ * Usage: int found = FindKShortestPaths(graph, source, target, k, paths, state);
+ * ------------------------------------------------------------------------------
+ * Fills paths with up to k loopless paths from source to target, shortest first. Paths of equal distance are
+ * ordered by number of arcs. Returns the number of paths found, which is less than k only if there are no more
+ * loopless paths. Needs non-negative arc distances.
+ */
+int FindKShortestPaths(graphT &graph, nodeT *source, nodeT *target, int k, Vector<rankedPathT> &paths,
+                       kShortestStateT &state);
+
+#endif
@@ -0,0 +1,157 @@
+/*
+ * File: landmarks.cpp
+ * -------------------
+ * This file implements the landmark selection, the binary file format of the tables and the ALT heuristic.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include "landmarks.h"
+#include "shortestpath.h"
+
+static_assert(sizeof(int) == 4, "landmark tables are stored as 32 bit integers");
+
+/*
+ * Type: landmarkHeaderT
+ * ---------------------
+ * The start of a landmark file. It is followed by landmarkCount landmark ids and nodeCount * landmarkCount
+ * distances, all 32 bit integers in the byte order of the machine that wrote them.
+ */
+struct landmarkHeaderT{
+	char magic[4];          // "ALT1"
+	int nodeCount;
+	int landmarkCount;
+	int arcCount;
+	long long distanceSum;  // sum of all arc distances of the graph the tables were built for
+};
+
+/* Points the table at a block holding the landmark ids followed by the distances */
+static void SetTableData(landmarkTableT &table, const int *data, int nodeCount, int landmarkCount){
+	table.nodeCount = nodeCount;
+	table.landmarkCount = landmarkCount;
+	table.landmarks = data;
+	table.dist = data + landmarkCount;
+}
+
+/* Releases whatever holds the tables and leaves the table empty */
+static void ClearLandmarkTable(landmarkTableT &table){
+	delete[] table.memory;
+	UnmapFile(table.file);
+	table = landmarkTableT();
+}
+
+void BuildLandmarkTable(graphT &graph, landmarkTableT &table, int landmarkCount){
+	ClearLandmarkTable(table);
+	int nodeCount = graph.nodeList.size();
+	if(landmarkCount > nodeCount) landmarkCount = nodeCount;
+	Vector<int> landmarks;
+	Vector<int> nearest;  // distance from each node to the nearest landmark picked so far
+	Vector<bool> picked;
+	for(int i = 0; i < nodeCount; i++){
+		nearest.add(INFINITE_DISTANCE);
+		picked.add(false);
+	}
+	searchStateT state;
+	if(nodeCount > 0){
+		// The first landmark is the node farthest from node 0
+		FindShortestPath(graph, graph.nodeList[0], NULL, state);
+		int first = 0;
+		for(int i = 1; i < nodeCount; i++)
+			if(state.dist[i] > state.dist[first]) first = i;
+		landmarks.add(first);
+	}
+	table.memory = new int[landmarkCount + nodeCount * landmarkCount];
+	int *dist = table.memory + landmarkCount;
+	for(int l = 0; l < landmarkCount; l++){
+		int landmark = landmarks[l];
+		picked[landmark] = true;
+		table.memory[l] = landmark;
+		FindShortestPath(graph, graph.nodeList[landmark], NULL, state);  // NULL target: settle every node
+		int next = -1;
+		for(int i = 0; i < nodeCount; i++){
+			dist[i * landmarkCount + l] = state.dist[i];
+			if(state.dist[i] < nearest[i]) nearest[i] = state.dist[i];
+			if(!picked[i] && (next == -1 || nearest[i] > nearest[next])) next = i;
+		}
+		if(l + 1 < landmarkCount) landmarks.add(next);
+	}
+	SetTableData(table, table.memory, nodeCount, landmarkCount);
+}
+
+bool SaveLandmarkTable(graphT &graph, landmarkTableT &table, string filename){
+	ofstream out(filename.c_str(), ios::binary);
+	if(out.fail()) return false;
+	landmarkHeaderT header;
+	memcpy(header.magic, "ALT1", 4);
+	header.nodeCount = table.nodeCount;
+	header.landmarkCount = table.landmarkCount;
+	header.arcCount = graph.arcs.size();
+	header.distanceSum = SumOfArcDistances(graph);
+	out.write((const char *)&header, sizeof(header));
+	out.write((const char *)table.landmarks, sizeof(int) * table.landmarkCount);
+	out.write((const char *)table.dist, sizeof(int) * table.landmarkCount * table.nodeCount);
+	return !out.fail();
+}
+
+bool LoadLandmarkTable(graphT &graph, landmarkTableT &table, string filename){
+	ClearLandmarkTable(table);
+	if(!MapFile(filename, table.file)) return false;
+	landmarkHeaderT header;
+	bool valid = (table.file.size >= sizeof(header));
+	if(valid){
+		memcpy(&header, table.file.data, sizeof(header));
+		valid = memcmp(header.magic, "ALT1", 4) == 0 && header.nodeCount == graph.nodeList.size() &&
+		        header.arcCount == graph.arcs.size() && header.distanceSum == SumOfArcDistances(graph) &&
+		        header.landmarkCount >= 0 && header.landmarkCount <= header.nodeCount &&
+		        table.file.size == sizeof(header) +
+		                           sizeof(int) * (size_t)header.landmarkCount * (1 + (size_t)header.nodeCount);
+	}
+	if(!valid){  // built for another graph
+		ClearLandmarkTable(table);
+		return false;
+	}
+	SetTableData(table, (const int *)(table.file.data + sizeof(header)), header.nodeCount, header.landmarkCount);
+	return true;
+}
+
+void FreeLandmarkTable(landmarkTableT *table){
+	if(table == NULL) return;
+	ClearLandmarkTable(*table);
+	delete table;
+}
+
+/* Loads the tables saved next to the graph file, or builds and saves them; only builds them once arcs have changed */
+landmarkTableT *GetLandmarkTable(graphT &graph){
+	if(graph.landmarks != NULL) return graph.landmarks;
+	landmarkTableT *table = new landmarkTableT;
+	string filename = graph.fileName + ".alt";
+	if(graph.updates > 0)  // the file describes the graph as it was read
+		BuildLandmarkTable(graph, *table, DEFAULT_LANDMARK_COUNT);
+	else if(!LoadLandmarkTable(graph, *table, filename)){
+		cout << "Building landmark tables..." << endl;
+		BuildLandmarkTable(graph, *table, DEFAULT_LANDMARK_COUNT);
+		if(!SaveLandmarkTable(graph, *table, filename))
+			cout << "Could not save the landmark tables to " << filename << endl;
+		else if(!LoadLandmarkTable(graph, *table, filename))  // use the mapped copy from now on
+			BuildLandmarkTable(graph, *table, DEFAULT_LANDMARK_COUNT);
+	}
+	graph.landmarks = table;
+	return table;
+}
+
+/* Largest |dist(L, target) - dist(L, node)| over the landmarks L that reach both nodes */
+int LandmarkHeuristic(nodeT *node, nodeT *target, void *clientData){
+	landmarkTableT *table = (landmarkTableT *)clientData;
+	int count = table->landmarkCount;
+	const int *fromNode = table->dist + (size_t)node->id * count;
+	const int *fromTarget = table->dist + (size_t)target->id * count;
+	int best = 0;
+	for(int i = 0; i < count; i++){
+		if(fromNode[i] == INFINITE_DISTANCE || fromTarget[i] == INFINITE_DISTANCE) continue;
+		int bound = fromTarget[i] - fromNode[i];
+		if(bound < 0) bound = -bound;
+		if(bound > best) best = bound;
+	}
+	return best;
+}
@@ -0,0 +1,85 @@
+/*
+ * File: landmarks.h
+ * -----------------
+ * This module exports the landmark tables for A* with landmarks and the triangle inequality (ALT). A few landmark
+ * nodes are picked far apart and the distance from every landmark to every node is stored. For any landmark L,
+ * |dist(L, target) - dist(L, node)| is a lower bound of dist(node, target), so the largest of these bounds is an
+ * A* heuristic that follows the arc distances, unlike the straight line heuristic, which depends on how well the
+ * node coordinates match them. The tables are saved next to the graph file and mapped into memory when loaded.
+ */
+
+#ifndef _landmarks_h
+#define _landmarks_h
+
+#include "genlib.h"
+#include "pathgraph.h"
+#include "mappedfile.h"
+
+/* Number of landmarks picked when the table is built for the user interface */
+const int DEFAULT_LANDMARK_COUNT = 8;
+
+/*
+ * Type: landmarkTableT
+ * --------------------
+ * The distance tables of a graph, laid out exactly as in the file: 32 bit integers, all landmark distances of node
+ * 0 first, then those of node 1 and so on, so the bounds of one node are adjacent in memory.
+ */
+struct landmarkTableT{
+	int nodeCount;
+	int landmarkCount;
+	const int *landmarks;  // node id of each landmark
+	const int *dist;       // dist[node * landmarkCount + i] is the distance between node and landmark i
+	int *memory;           // the tables while they are held in memory rather than mapped, NULL otherwise
+	mappedFileT file;      // the mapped file holding the tables, if any
+
+	landmarkTableT() : nodeCount(0), landmarkCount(0), landmarks(NULL), dist(NULL), memory(NULL) {}
+};
+
+/*
+ * Function: BuildLandmarkTable
+ * Usage: BuildLandmarkTable(graph, table, DEFAULT_LANDMARK_COUNT);
+ * ----------------------------------------------------------------
+ * Picks up to landmarkCount landmarks by farthest selection (each new landmark is the node farthest from the ones
+ * picked so far; unreachable nodes count as farthest, so every component gets one) and runs one complete Dijkstra
+ * search per landmark to fill the table. The table is held in memory.
+ */
+void BuildLandmarkTable(graphT &graph, landmarkTableT &table, int landmarkCount);
+
+/*
+ * Function: SaveLandmarkTable, LoadLandmarkTable
+ * Usage: SaveLandmarkTable(graph, table, filename);
+ *        if(LoadLandmarkTable(graph, table, filename)) ...
+ * -----------------------------------------------------
+ * Writes the tables to a binary file, or maps such a file into memory. Loading fails if the file is missing or was
+ * built for a different graph.
+ */
+bool SaveLandmarkTable(graphT &graph, landmarkTableT &table, string filename);
+bool LoadLandmarkTable(graphT &graph, landmarkTableT &table, string filename);
+
+/*
+ * Function: FreeLandmarkTable
+ * Usage: FreeLandmarkTable(table);
+ * --------------------------------
+ * Releases the memory or mapping of a table allocated with new, and the table itself. NULL is ignored.
+ */
+void FreeLandmarkTable(landmarkTableT *table);
+
+/*
+ * Function: GetLandmarkTable
+ * Usage: landmarkTableT *table = GetLandmarkTable(graph);
+ * -------------------------------------------------------
+ * Returns graph.landmarks, first loading it from the file next to the graph file or, if there is none, building
+ * and saving it. Once arc distances have been updated it is built in memory only.
+ */
+landmarkTableT *GetLandmarkTable(graphT &graph);
+
+/*
+ * Function: LandmarkHeuristic
+ * Usage: FindShortestPath(graph, source, target, state, LandmarkHeuristic, table);
+ * --------------------------------------------------------------------------------
+ * The ALT heuristic: the largest triangle inequality bound over all landmarks. clientData must point to the
+ * landmarkTableT of the graph. The bound is consistent, so FindShortestPath stays exact.
+ */
+int LandmarkHeuristic(nodeT *node, nodeT *target, void *clientData);
+
+#endif
@@ -0,0 +1,77 @@
+/*
+ * File: mappedfile.cpp
+ * --------------------
+ * This file implements the read only file mapping for Windows and for POSIX systems.
+ */
+
+#include "mappedfile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+
+bool MapFile(string filename, mappedFileT &file){
+	UnmapFile(file);
+	HANDLE fileHandle = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+	                                FILE_ATTRIBUTE_NORMAL, NULL);
+	if(fileHandle == INVALID_HANDLE_VALUE) return false;
+	LARGE_INTEGER size;
+	if(!GetFileSizeEx(fileHandle, &size) || size.QuadPart == 0){
+		CloseHandle(fileHandle);
+		return false;
+	}
+	HANDLE mappingHandle = CreateFileMappingA(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+	if(mappingHandle == NULL){
+		CloseHandle(fileHandle);
+		return false;
+	}
+	void *view = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+	if(view == NULL){
+		CloseHandle(mappingHandle);
+		CloseHandle(fileHandle);
+		return false;
+	}
+	file.data = (const char *)view;
+	file.size = (size_t)size.QuadPart;
+	file.fileHandle = fileHandle;
+	file.mappingHandle = mappingHandle;
+	return true;
+}
+
+void UnmapFile(mappedFileT &file){
+	if(file.data == NULL) return;
+	UnmapViewOfFile(file.data);
+	CloseHandle((HANDLE)file.mappingHandle);
+	CloseHandle((HANDLE)file.fileHandle);
+	file = mappedFileT();
+}
+
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+bool MapFile(string filename, mappedFileT &file){
+	UnmapFile(file);
+	int fd = open(filename.c_str(), O_RDONLY);
+	if(fd < 0) return false;
+	struct stat info;
+	if(fstat(fd, &info) != 0 || info.st_size == 0){
+		close(fd);
+		return false;
+	}
+	void *view = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);  // the mapping keeps the file open
+	if(view == MAP_FAILED) return false;
+	file.data = (const char *)view;
+	file.size = (size_t)info.st_size;
+	return true;
+}
+
+void UnmapFile(mappedFileT &file){
+	if(file.data == NULL) return;
+	munmap((void *)file.data, file.size);
+	file = mappedFileT();
+}
+
+#endif
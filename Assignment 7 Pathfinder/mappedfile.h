@@ -0,0 +1,45 @@
+/*
+ * File: mappedfile.h
+ * ------------------
+ * This module exports a read only view of a whole file through the memory mapping of the operating system
+ * (MapViewOfFile on Windows, mmap elsewhere). The file is paged in on demand and shared between processes, so a
+ * large table can be used without reading it first.
+ */
+
+#ifndef _mappedfile_h
+#define _mappedfile_h
+
+#include <cstddef>
+#include "genlib.h"
+
+/*
+ * Type: mappedFileT
+ * -----------------
+ * A file mapped into memory. The handles are those of the operating system and only used by UnmapFile.
+ */
+struct mappedFileT{
+	const char *data;      // first byte of the file, NULL if nothing is mapped
+	size_t size;           // length of the file in bytes
+	void *fileHandle;
+	void *mappingHandle;
+
+	mappedFileT() : data(NULL), size(0), fileHandle(NULL), mappingHandle(NULL) {}
+};
+
+/*
+ * Function: MapFile
+ * Usage: if(MapFile(filename, file)) ...
+ * --------------------------------------
+ * Maps the named file read only. Returns false if the file cannot be opened, is empty or cannot be mapped.
+ */
+bool MapFile(string filename, mappedFileT &file);
+
+/*
+ * Function: UnmapFile
+ * Usage: UnmapFile(file);
+ * -----------------------
+ * Releases the mapping and the file. Does nothing if nothing is mapped.
+ */
+void UnmapFile(mappedFileT &file);
+
+#endif
@@ -0,0 +1,343 @@
+/*
+ * File: mst.cpp
+ * -------------
+ * This file implements the disjoint set forest, Kruskal's and Prim's algorithms and the choice of engine.
+ */
+
+#include <cmath>
+#include <climits>
+#include <sstream>
+#include "mst.h"
+#include "pqueue.h"
+
+void InitDisjointSet(disjointSetT &sets, int count){
+	sets.parent.clear();
+	sets.rank.clear();
+	for(int i = 0; i < count; i++){
+		sets.parent.add(i);
+		sets.rank.add(0);
+	}
+	sets.sets = count;
+}
+
+/* Path halving: every node on the way is linked to its grandparent, in a single pass */
+int FindSet(disjointSetT &sets, int element){
+	while(sets.parent[element] != element){
+		sets.parent[element] = sets.parent[sets.parent[element]];
+		element = sets.parent[element];
+	}
+	return element;
+}
+
+bool UnionSets(disjointSetT &sets, int a, int b){
+	int rootA = FindSet(sets, a);
+	int rootB = FindSet(sets, b);
+	if(rootA == rootB) return false;
+	if(sets.rank[rootA] < sets.rank[rootB])
+		sets.parent[rootA] = rootB;
+	else if(sets.rank[rootA] > sets.rank[rootB])
+		sets.parent[rootB] = rootA;
+	else{
+		sets.parent[rootB] = rootA;
+		sets.rank[rootA]++;
+	}
+	sets.sets--;
+	return true;
+}
+
+/* Function: CmpByDistanceAndId
+ * ----------------------------
+ * This function gives the order of the arcs shared by all engines. The arc with shorter distance is given higher
+ * priority, and of two equally long arcs the one with the lower id.
+ */
+int CmpByDistanceAndId(arcT *arc1, arcT *arc2){
+	if(arc1->distance != arc2->distance)
+		return (arc1->distance < arc2->distance) ? 1 : -1;
+	if(arc1->id != arc2->id)
+		return (arc1->id < arc2->id) ? 1 : -1;
+	return 0;
+}
+
+/* Number of arcs counted at once into separate copies of the counters */
+const int HISTOGRAM_LANES = 4;
+
+/*
+ * Counts the digits (key >> shift) & mask of keys[begin, end) into counts, which has mask + 1 entries. Runs of equal
+ * digits, common in road graphs where many arcs share a distance, would make every increment wait for the previous
+ * one to the same counter; with few buckets the loop spreads consecutive keys over several copies of the counters.
+ */
+static void CountDigits(vector<unsigned int> &keys, int begin, int end, int shift, unsigned int mask, int *counts){
+	int buckets = mask + 1;
+	for(int b = 0; b < buckets; b++)
+		counts[b] = 0;
+	const unsigned int *key = keys.data();
+	int i = begin;
+	if(buckets <= (1 << RADIX_BITS)){
+		vector<int> lanes(HISTOGRAM_LANES * buckets, 0);
+		int *lane0 = lanes.data(), *lane1 = lane0 + buckets, *lane2 = lane1 + buckets, *lane3 = lane2 + buckets;
+		for(; i + HISTOGRAM_LANES <= end; i += HISTOGRAM_LANES){
+			lane0[(key[i] >> shift) & mask]++;
+			lane1[(key[i + 1] >> shift) & mask]++;
+			lane2[(key[i + 2] >> shift) & mask]++;
+			lane3[(key[i + 3] >> shift) & mask]++;
+		}
+		for(int b = 0; b < buckets; b++)
+			counts[b] = lane0[b] + lane1[b] + lane2[b] + lane3[b];
+	}
+	for(; i < end; i++)
+		counts[(key[i] >> shift) & mask]++;
+}
+
+/*
+ * One stable pass of the sort by the digits (key >> shift) & mask, from keys and ids into sortedKeys and sortedIds,
+ * split into blocks that are counted and moved in parallel. Returns false without moving anything if all keys have
+ * the same digit.
+ */
+static bool SortPass(vector<unsigned int> &keys, vector<int> &ids, vector<unsigned int> &sortedKeys,
+                     vector<int> &sortedIds, int shift, unsigned int mask, int blocks, WorkerPool *pool){
+	int count = keys.size();
+	int buckets = mask + 1;
+	vector<int> counts(blocks * buckets);  // block b counts at counts[b * buckets], then its first slots
+	auto blockStart = [count, blocks](int block){ return (int)((long long)count * block / blocks); };
+	auto countBlock = [&](int block, int /*thread*/){
+		CountDigits(keys, blockStart(block), blockStart(block + 1), shift, mask, &counts[block * buckets]);
+	};
+	if(blocks > 1)
+		pool->parallelFor(blocks, 1, countBlock);
+	else
+		countBlock(0, 0);
+	// The first slot of each bucket and block: buckets in order, and within a bucket the blocks in order
+	int next = 0;
+	for(int digit = 0; digit < buckets; digit++){
+		int total = 0;
+		for(int block = 0; block < blocks; block++){
+			int &slot = counts[block * buckets + digit];
+			int size = slot;
+			slot = next + total;
+			total += size;
+		}
+		if(total == count) return false;
+		next += total;
+	}
+	auto moveBlock = [&](int block, int /*thread*/){
+		int *slot = &counts[block * buckets];
+		for(int i = blockStart(block); i < blockStart(block + 1); i++){
+			int to = slot[(keys[i] >> shift) & mask]++;
+			sortedKeys[to] = keys[i];
+			sortedIds[to] = ids[i];
+		}
+	};
+	if(blocks > 1)
+		pool->parallelFor(blocks, 1, moveBlock);
+	else
+		moveBlock(0, 0);
+	return true;
+}
+
+void SortArcsByDistance(graphT &graph, vector<int> &order, WorkerPool *pool){
+	int count = graph.arcs.size();
+	order.resize(count);
+	if(count == 0) return;
+	long long lowest = graph.arcs[0]->distance, highest = lowest;
+	for(int i = 1; i < count; i++){
+		long long distance = graph.arcs[i]->distance;
+		if(distance < lowest) lowest = distance;
+		if(distance > highest) highest = distance;
+	}
+	// Keys are the distances above the lowest, which fit in 32 bits even if some distances are negative
+	vector<unsigned int> keys(count), sortedKeys(count);
+	vector<int> sortedIds(count);
+	for(int i = 0; i < count; i++){
+		keys[i] = (unsigned int)(graph.arcs[i]->distance - lowest);
+		order[i] = graph.arcs[i]->id;
+	}
+	unsigned int range = (unsigned int)(highest - lowest);
+	int blocks = (pool != NULL && count >= PARALLEL_SORT_MIN) ? pool->threadCount() : 1;
+	if(range < (unsigned int)COUNTING_SORT_RANGE && range < (unsigned int)count){
+		unsigned int mask = 0;
+		while(mask < range)
+			mask = (mask << 1) | 1;
+		if(SortPass(keys, order, sortedKeys, sortedIds, 0, mask, blocks, pool))
+			order.swap(sortedIds);
+		return;
+	}
+	const unsigned int digitMask = (1u << RADIX_BITS) - 1;
+	for(int shift = 0; shift < 32 && (range >> shift) != 0; shift += RADIX_BITS){
+		if(SortPass(keys, order, sortedKeys, sortedIds, shift, digitMask, blocks, pool)){
+			keys.swap(sortedKeys);
+			order.swap(sortedIds);
+		}
+	}
+}
+
+void KruskalSpanningTree(graphT &graph, spanningTreeT &tree, WorkerPool *pool){
+	int nodeCount = graph.nodeList.size();
+	tree.arcs.clear();
+	tree.distance = 0;
+	vector<int> order;
+	SortArcsByDistance(graph, order, pool);
+	disjointSetT components;
+	InitDisjointSet(components, nodeCount);
+	for(size_t i = 0; i < order.size() && tree.arcs.size() < nodeCount - 1; i++){
+		arcT *arc = graph.arcs[order[i]];
+		if(UnionSets(components, arc->start->id, arc->end->id)){
+			tree.arcs.add(arc);
+			tree.distance += arc->distance;
+		}
+	}
+	tree.components = components.sets;
+}
+
+/* True if arc1 comes before arc2 in the order of CmpByDistanceAndId */
+static inline bool ShorterArc(arcT *arc1, arcT *arc2){
+	return CmpByDistanceAndId(arc1, arc2) > 0;
+}
+
+/* Adds arc to the tree of the Prim engines, which know it joins a new node */
+static inline void AddTreeArc(spanningTreeT &tree, arcT *arc){
+	tree.arcs.add(arc);
+	tree.distance += arc->distance;
+}
+
+/*
+ * Type: primEntryT
+ * ----------------
+ * An element of the Prim heap: a node outside the tree and the shortest arc known to join it to the tree.
+ */
+struct primEntryT{
+	int node;
+	arcT *arc;
+};
+
+/* Function: CmpPrimEntries
+ * ------------------------
+ * This function is the callback function for the Prim heap. The entry with the shorter arc gets higher priority.
+ */
+int CmpPrimEntries(primEntryT entry1, primEntryT entry2){
+	return CmpByDistanceAndId(entry1.arc, entry2.arc);
+}
+
+void PrimSpanningTree(graphT &graph, spanningTreeT &tree){
+	int nodeCount = graph.nodeList.size();
+	tree.arcs.clear();
+	tree.distance = 0;
+	tree.components = 0;
+	Vector<bool> inTree;
+	Vector<arcT *> joining;  // node id -> shortest arc known to join it to the tree, NULL if none
+	Vector<int> handle;      // node id -> handle in the heap, valid while joining is not NULL and inTree false
+	for(int i = 0; i < nodeCount; i++){
+		inTree.add(false);
+		joining.add(NULL);
+		handle.add(-1);
+	}
+	IndexedPQueue<primEntryT> pq(CmpPrimEntries);
+	for(int start = 0; start < nodeCount; start++){
+		if(inTree[start]) continue;
+		tree.components++;
+		int node = start;
+		while(true){
+			inTree[node] = true;
+			nodeT *from = graph.nodeList[node];
+			for(int i = 0; i < from->arcs.size(); i++){
+				arcT *arc = from->arcs[i];
+				int next = OtherEnd(arc, from)->id;
+				if(inTree[next]) continue;
+				primEntryT entry = {next, arc};
+				if(joining[next] == NULL)
+					handle[next] = pq.enqueue(entry);
+				else if(ShorterArc(arc, joining[next]))
+					pq.increaseKey(handle[next], entry);
+				else
+					continue;
+				joining[next] = arc;
+			}
+			if(pq.isEmpty()) break;
+			primEntryT entry = pq.dequeueMax();
+			AddTreeArc(tree, entry.arc);
+			node = entry.node;
+		}
+	}
+}
+
+/*
+ * The dense Prim scan compares packed keys, distance in the high half, shifted to be non negative, and arc id in the
+ * low half, which orders the arcs as CmpByDistanceAndId does.
+ */
+static const unsigned long long NOT_JOINED = ~0ULL;
+
+static inline unsigned long long PackedArcKey(arcT *arc){
+	return ((unsigned long long)((long long)arc->distance - INT_MIN) << 32) | (unsigned int)arc->id;
+}
+
+void DensePrimSpanningTree(graphT &graph, spanningTreeT &tree){
+	int nodeCount = graph.nodeList.size();
+	tree.arcs.clear();
+	tree.distance = 0;
+	tree.components = 0;
+	// The nodes outside the tree, in no particular order, next to the key of their shortest joining arc, so that
+	// the scan for the next node runs over one packed array
+	Vector<int> outside;
+	Vector<unsigned long long> outsideKey;
+	Vector<int> position;  // node id -> index in outside, -1 once in the tree
+	for(int i = 0; i < nodeCount; i++){
+		outside.add(i);
+		outsideKey.add(NOT_JOINED);
+		position.add(i);
+	}
+	while(!outside.isEmpty()){
+		// Take the joined node with the shortest arc, or start a new tree if no node is joined
+		int best = 0;
+		for(int i = 1; i < outsideKey.size(); i++){
+			if(outsideKey[i] < outsideKey[best]) best = i;
+		}
+		if(outsideKey[best] == NOT_JOINED)
+			tree.components++;
+		else
+			AddTreeArc(tree, graph.arcs[(int)(outsideKey[best] & 0xFFFFFFFFu)]);
+		int node = outside[best];
+		int last = outside.size() - 1;
+		outside[best] = outside[last];
+		outsideKey[best] = outsideKey[last];
+		position[outside[best]] = best;
+		outside.removeAt(last);
+		outsideKey.removeAt(last);
+		position[node] = -1;
+		nodeT *from = graph.nodeList[node];
+		for(int i = 0; i < from->arcs.size(); i++){
+			arcT *arc = from->arcs[i];
+			int index = position[OtherEnd(arc, from)->id];
+			if(index < 0) continue;
+			unsigned long long key = PackedArcKey(arc);
+			if(key < outsideKey[index]) outsideKey[index] = key;
+		}
+	}
+}
+
+spanningTreeEngineT ChooseSpanningTreeEngine(graphT &graph, int numThreads, string &reason){
+	double nodes = graph.nodeList.size();
+	double arcs = graph.arcs.size();
+	ostringstream why;
+	spanningTreeEngineT engine;
+	if(nodes >= 2 && arcs * log2(nodes) >= nodes * nodes){
+		why << "the graph is dense (" << arcs << " arcs for " << nodes << " nodes, E log V >= V^2), so scanning an "
+		    << "array of all nodes for each node is cheaper than a heap";
+		engine = DENSE_PRIM_ENGINE;
+	}
+	else if(arcs >= PRIM_MIN_DEGREE * nodes){
+		why << "the graph has " << arcs / nodes << " arcs per node, so growing the tree on a heap of nodes is "
+		    << "cheaper than sorting all arcs";
+		engine = PRIM_ENGINE;
+	}
+	else if(nodes >= BORUVKA_MIN_NODES && numThreads > 1){
+		why << "the graph is large (" << nodes << " nodes) and sparse, so the rounds run in parallel on "
+		    << numThreads << " threads";
+		engine = BORUVKA_ENGINE;
+	}
+	else{
+		why << "the graph is sparse (" << arcs / (nodes > 0 ? nodes : 1) << " arcs per node), so sorting its few "
+		    << "arcs is cheapest";
+		engine = KRUSKAL_ENGINE;
+	}
+	reason = why.str();
+	return engine;
+}
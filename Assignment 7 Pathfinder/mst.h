@@ -0,0 +1,146 @@
+/*
+ * File: mst.h
+ * -----------
+ * This module exports the sequential minimal spanning tree engines and the choice between all engines. Kruskal's
+ * algorithm takes the arcs shortest first and keeps every arc that joins two different components; the components
+ * live in a disjoint set forest over the dense node ids. Prim's algorithm grows one tree at a time from a start node,
+ * always adding the shortest arc that leaves it, and never sorts the arcs. If the graph is not connected the result
+ * is a minimal spanning forest, one tree per component.
+ *
+ * All engines break ties between equally long arcs by arc id. With this order all arcs compare differently and the
+ * minimal spanning forest is unique, so every engine finds the same arcs; only the order of tree.arcs differs.
+ */
+
+#ifndef _mst_h
+#define _mst_h
+
+#include "genlib.h"
+#include "vector.h"
+#include "pathgraph.h"
+#include "parallel.h"
+
+/*
+ * Type: disjointSetT
+ * ------------------
+ * A disjoint set forest over the elements 0 .. count-1. Each set is a tree of parent links whose root stands for
+ * the set. Finding a root halves the path on the way (every node is linked to its grandparent), and a union hangs
+ * the root of lower rank below the other, which together keep the trees almost flat.
+ */
+struct disjointSetT{
+	Vector<int> parent;  // parent of each element, the element itself for a root
+	Vector<int> rank;    // upper bound on the height of the tree below each root
+	int sets;            // number of disjoint sets
+};
+
+/*
+ * Function: InitDisjointSet
+ * Usage: InitDisjointSet(sets, graph.nodeList.size());
+ * ----------------------------------------------------
+ * Puts every element 0 .. count-1 into a set of its own.
+ */
+void InitDisjointSet(disjointSetT &sets, int count);
+
+/*
+ * Function: FindSet
+ * Usage: if(FindSet(sets, a) == FindSet(sets, b)) ...
+ * ---------------------------------------------------
+ * Returns the root of the set holding element, halving the path to it.
+ */
+int FindSet(disjointSetT &sets, int element);
+
+/*
+ * Function: UnionSets
+ * Usage: if(UnionSets(sets, a, b)) ...
+ * ------------------------------------
+ * Merges the sets holding a and b, by rank. Returns false if they were already in the same set.
+ */
+bool UnionSets(disjointSetT &sets, int a, int b);
+
+/*
+ * Type: spanningTreeT
+ * -------------------
+ * A minimal spanning forest.
+ */
+struct spanningTreeT{
+	Vector<arcT *> arcs;  // arcs of the forest, in the order they were chosen
+	long long distance;   // sum of their distances
+	int components;       // number of trees, 1 if the graph is connected
+};
+
+/*
+ * Function: SortArcsByDistance
+ * Usage: SortArcsByDistance(graph, order);
+ *        SortArcsByDistance(graph, order, &pool);
+ * -----------------------------------------------
+ * Fills order with the ids of all arcs of the graph in increasing order of distance, equal distances in increasing
+ * order of id. Sorts by integer keys instead of comparisons: a single counting sort if the distances span fewer than
+ * COUNTING_SORT_RANGE values and fewer values than there are arcs, else a least significant digit radix sort with
+ * RADIX_BITS bits per pass, skipping passes over digits that all arcs share. Both are stable and start from the arcs
+ * in id order, which gives the order of equal distances for free. With a pool of several threads and at least
+ * PARALLEL_SORT_MIN arcs, each thread counts and moves its own block of the arcs.
+ */
+const int RADIX_BITS = 11;
+const int COUNTING_SORT_RANGE = 1 << 16;
+const int PARALLEL_SORT_MIN = 1 << 16;
+void SortArcsByDistance(graphT &graph, vector<int> &order, WorkerPool *pool = NULL);
+
+/*
+ * Function: KruskalSpanningTree
+ * Usage: KruskalSpanningTree(graph, tree);
+ *        KruskalSpanningTree(graph, tree, &pool);
+ * -----------------------------------------------
+ * Fills tree with a minimal spanning forest of the graph by Kruskal's algorithm, walking the arcs in the order of
+ * SortArcsByDistance, which sorts with the threads of pool if one is given. Arcs of equal distance are taken in order
+ * of arc id, so the result is always the same forest. Stops as soon as the forest has nodeCount - 1 arcs, since the
+ * graph is connected then and no later arc can join two components.
+ */
+void KruskalSpanningTree(graphT &graph, spanningTreeT &tree, WorkerPool *pool = NULL);
+
+/*
+ * Function: PrimSpanningTree
+ * Usage: PrimSpanningTree(graph, tree);
+ * -------------------------------------
+ * Fills tree with the minimal spanning forest of the graph by Prim's algorithm on an addressable heap: each node
+ * outside the tree is queued once, under the shortest arc that joins it to the tree, and moved up when a shorter
+ * one turns up. Takes O(E log V) time. The arcs of tree are in the order they were added.
+ */
+void PrimSpanningTree(graphT &graph, spanningTreeT &tree);
+
+/*
+ * Function: DensePrimSpanningTree
+ * Usage: DensePrimSpanningTree(graph, tree);
+ * ------------------------------------------
+ * Prim's algorithm with the shortest joining arc of each node in a plain array, scanned in full for the next node.
+ * Takes O(V^2 + E) time, which beats the heap when the graph has close to V^2 arcs. The arcs of tree are in the order
+ * they were added.
+ */
+void DensePrimSpanningTree(graphT &graph, spanningTreeT &tree);
+
+/*
+ * Type: spanningTreeEngineT
+ * -------------------------
+ * The minimal spanning tree engines. BORUVKA_ENGINE is BoruvkaSpanningTree of the parallelmst module.
+ */
+enum spanningTreeEngineT{
+	KRUSKAL_ENGINE,
+	PRIM_ENGINE,
+	DENSE_PRIM_ENGINE,
+	BORUVKA_ENGINE
+};
+
+/*
+ * Function: ChooseSpanningTreeEngine
+ * Usage: spanningTreeEngineT engine = ChooseSpanningTreeEngine(graph, numThreads, reason);
+ * ----------------------------------------------------------------------------------------
+ * Picks the engine for the graph from its size and density, with numThreads threads available, and sets reason to
+ * a sentence that explains the choice:
+ *   - DENSE_PRIM_ENGINE if E log V >= V^2, where scanning an array of V entries per node is no dearer than the heap;
+ *   - PRIM_ENGINE if there are at least PRIM_MIN_DEGREE arcs per node, too many to sort them all;
+ *   - BORUVKA_ENGINE for a sparse graph of at least BORUVKA_MIN_NODES nodes and more than one thread;
+ *   - KRUSKAL_ENGINE otherwise, for small sparse graphs, where sorting the few arcs is cheapest.
+ */
+const int PRIM_MIN_DEGREE = 8;
+const int BORUVKA_MIN_NODES = 50000;
+spanningTreeEngineT ChooseSpanningTreeEngine(graphT &graph, int numThreads, string &reason);
+
+#endif
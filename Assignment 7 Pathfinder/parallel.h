@@ -0,0 +1,183 @@
+/*
+ * File: parallel.h
+ * ----------------
+ * Small helpers for spreading independent pieces of work over the cores of the machine. The work items must not
+ * write to shared data except through slots that belong to their own index, which keeps the results independent of
+ * how the items happen to be scheduled.
+ */
+
+#ifndef _parallel_h
+#define _parallel_h
+
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+
+/*
+ * Function: DefaultThreadCount
+ * Usage: int numThreads = DefaultThreadCount();
+ * ---------------------------------------------
+ * Returns the number of hardware threads, or 1 if the platform cannot tell.
+ */
+inline int DefaultThreadCount(){
+	int count = (int)std::thread::hardware_concurrency();
+	return (count > 0) ? count : 1;
+}
+
+/*
+ * Function: ParallelFor
+ * Usage: ParallelFor(count, numThreads, fn);
+ * ------------------------------------------
+ * Calls fn(index, thread) once for every index in 0 .. count-1, using up to numThreads threads. thread is the
+ * number (0 .. numThreads-1) of the thread running the call, so fn can keep per thread scratch state in an array
+ * indexed by it. Items are handed out one at a time, so uneven items still balance. With one thread, or a single
+ * item, everything runs on the calling thread in index order. If a call throws, the threads take no further items,
+ * and the first exception is thrown again on the calling thread once all threads have stopped.
+ */
+template <typename FunctorType>
+void ParallelFor(int count, int numThreads, FunctorType fn){
+	if(numThreads > count) numThreads = count;
+	if(numThreads <= 1){
+		for(int i = 0; i < count; i++)
+			fn(i, 0);
+		return;
+	}
+	std::atomic<int> next(0);
+	std::exception_ptr failure;  // first exception thrown by fn
+	std::mutex failureLock;
+	std::vector<std::thread> workers;
+	for(int t = 0; t < numThreads; t++){
+		workers.push_back(std::thread([&next, &fn, &failure, &failureLock, count, t](){
+			try{
+				while(true){
+					int index = next++;
+					if(index >= count) break;
+					fn(index, t);
+				}
+			}
+			catch(...){
+				std::lock_guard<std::mutex> guard(failureLock);
+				if(!failure) failure = std::current_exception();
+				next = count;  // the other threads stop at their next item
+			}
+		}));
+	}
+	for(int t = 0; t < numThreads; t++)
+		workers[t].join();
+	if(failure) std::rethrow_exception(failure);
+}
+
+/*
+ * Class: WorkerPool
+ * -----------------
+ * A set of threads that stay alive between parallel loops, for algorithms that run many short loops one after the
+ * other, where starting fresh threads for each loop as ParallelFor does would cost more than the loop itself.
+ * The calling thread works along as thread 0. Items are handed out in chunks from a shared counter, so a thread
+ * that finishes early takes over the remaining chunks of the others.
+ */
+class WorkerPool{
+	public:
+		/* Starts numThreads - 1 helper threads */
+		WorkerPool(int numThreads) : job(NULL), jobCount(0), chunkSize(1), generation(0), busy(0), stopping(false){
+			if(numThreads < 1) numThreads = 1;
+			for(int t = 1; t < numThreads; t++)
+				workers.push_back(std::thread(&WorkerPool::workerLoop, this, t));
+		}
+
+		/* Stops and joins the helper threads */
+		~WorkerPool(){
+			{
+				std::lock_guard<std::mutex> guard(lock);
+				stopping = true;
+			}
+			wake.notify_all();
+			for(size_t t = 0; t < workers.size(); t++)
+				workers[t].join();
+		}
+
+		/* Returns the number of threads, counting the calling thread */
+		int threadCount(){
+			return (int)workers.size() + 1;
+		}
+
+		/*
+		 * Member function: parallelFor
+		 * Usage: pool.parallelFor(count, chunkSize, fn);
+		 * ----------------------------------------------
+		 * Same contract as ParallelFor: calls fn(index, thread) once for every index in 0 .. count-1 and returns when
+		 * all calls are done. Indices are handed out chunkSize at a time.
+		 */
+		void parallelFor(int count, int chunkSize, const std::function<void(int, int)> &fn){
+			if(count <= 0) return;
+			if(workers.empty() || count <= chunkSize){
+				for(int i = 0; i < count; i++)
+					fn(i, 0);
+				return;
+			}
+			{
+				std::lock_guard<std::mutex> guard(lock);
+				job = &fn;
+				jobCount = count;
+				this->chunkSize = (chunkSize < 1) ? 1 : chunkSize;
+				next = 0;
+				busy = (int)workers.size();
+				generation++;
+			}
+			wake.notify_all();
+			runItems(0);
+			std::unique_lock<std::mutex> guard(lock);
+			done.wait(guard, [this](){ return busy == 0; });
+			job = NULL;
+		}
+
+	private:
+		std::vector<std::thread> workers;
+		std::mutex lock;
+		std::condition_variable wake, done;
+		const std::function<void(int, int)> *job;  // loop body of the current loop, NULL between loops
+		int jobCount;
+		int chunkSize;
+		std::atomic<int> next;                     // first index not handed out yet
+		int generation;                            // number of loops started, to tell a new loop from a spurious wakeup
+		int busy;                                  // helper threads still working on the current loop
+		bool stopping;
+
+		/* Takes chunks of the current loop till none is left */
+		void runItems(int thread){
+			while(true){
+				int first = next.fetch_add(chunkSize);
+				if(first >= jobCount) break;
+				int last = (first + chunkSize < jobCount) ? first + chunkSize : jobCount;
+				for(int i = first; i < last; i++)
+					(*job)(i, thread);
+			}
+		}
+
+		/* Waits for a loop, helps with it and reports back */
+		void workerLoop(int thread){
+			int seen = 0;
+			while(true){
+				{
+					std::unique_lock<std::mutex> guard(lock);
+					wake.wait(guard, [this, seen](){ return stopping || generation != seen; });
+					if(stopping) return;
+					seen = generation;
+				}
+				runItems(thread);
+				{
+					std::lock_guard<std::mutex> guard(lock);
+					busy--;
+				}
+				done.notify_one();
+			}
+		}
+
+		WorkerPool(const WorkerPool &);
+		WorkerPool &operator=(const WorkerPool &);
+};
+
+#endif
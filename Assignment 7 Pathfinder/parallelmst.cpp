@@ -0,0 +1,226 @@
+/*
+ * File: parallelmst.cpp
+ * ---------------------
+ * This file implements the filter-Kruskal and Boruvka engines and their benchmark.
+ */
+
+#include <iostream>
+#include <chrono>
+#include <algorithm>
+#include <climits>
+#include "parallelmst.h"
+
+/*
+ * The order of the arcs is packed into one 64 bit key, distance in the high half, shifted to be non negative, and
+ * arc id in the low half. Keys of different arcs always differ, and Boruvka can pick the shortest arc of a component
+ * with a single atomic minimum.
+ */
+typedef unsigned long long arcKeyT;
+const arcKeyT NO_ARC_KEY = ~0ULL;
+
+/* Number of items a thread takes at a time */
+const int ARC_CHUNK = 1024;
+const int NODE_CHUNK = 1024;
+
+/* Filter-Kruskal sorts ranges of at most this many arcs directly */
+const int FILTER_KRUSKAL_BASE = 1024;
+
+/* Smaller ranges are filtered on the calling thread only */
+const int PARALLEL_FILTER_MIN = 8192;
+
+static inline arcKeyT ArcKey(arcT *arc){
+	return ((arcKeyT)((long long)arc->distance - INT_MIN) << 32) | (unsigned int)arc->id;
+}
+
+static inline bool ArcKeyLess(arcT *arc1, arcT *arc2){
+	return ArcKey(arc1) < ArcKey(arc2);
+}
+
+/* The root of the set of element, without shortening the path, so that several threads may look up at once */
+static inline int FindSetReadOnly(disjointSetT &sets, int element){
+	while(sets.parent[element] != element)
+		element = sets.parent[element];
+	return element;
+}
+
+/* Adds arc to tree if it joins two components */
+static inline void TryArc(disjointSetT &sets, spanningTreeT &tree, arcT *arc){
+	if(UnionSets(sets, arc->start->id, arc->end->id)){
+		tree.arcs.add(arc);
+		tree.distance += arc->distance;
+	}
+}
+
+/*
+ * Type: filterRunT
+ * ----------------
+ * The state shared by the recursion of one filter-Kruskal run.
+ */
+struct filterRunT{
+	WorkerPool *pool;
+	disjointSetT sets;
+	spanningTreeT *tree;
+	int treeSize;          // arcs of a spanning tree of a connected graph, the run stops when it has them
+	vector<char> keep;     // scratch flags of the filter pass
+};
+
+/* Removes the arcs in [begin, end) whose end points are already joined, returns the new end */
+static int FilterArcs(filterRunT &run, vector<arcT *> &arcs, int begin, int end){
+	int count = end - begin;
+	if(count < PARALLEL_FILTER_MIN){
+		int last = begin;
+		for(int i = begin; i < end; i++){
+			if(FindSet(run.sets, arcs[i]->start->id) != FindSet(run.sets, arcs[i]->end->id))
+				arcs[last++] = arcs[i];
+		}
+		return last;
+	}
+	// Only lookups run in parallel, no unions, so the parent links stay still
+	run.pool->parallelFor(count, ARC_CHUNK, [&](int i, int){
+		arcT *arc = arcs[begin + i];
+		run.keep[begin + i] = FindSetReadOnly(run.sets, arc->start->id) != FindSetReadOnly(run.sets, arc->end->id);
+	});
+	int last = begin;
+	for(int i = begin; i < end; i++){
+		if(run.keep[i]) arcs[last++] = arcs[i];
+	}
+	return last;
+}
+
+/* Adds the tree arcs among arcs[begin, end), which all are longer than the arcs handled before */
+static void FilterKruskal(filterRunT &run, vector<arcT *> &arcs, int begin, int end){
+	if(run.tree->arcs.size() >= run.treeSize) return;
+	if(end - begin <= FILTER_KRUSKAL_BASE){
+		sort(arcs.begin() + begin, arcs.begin() + end, ArcKeyLess);
+		for(int i = begin; i < end && run.tree->arcs.size() < run.treeSize; i++)
+			TryArc(run.sets, *run.tree, arcs[i]);
+		return;
+	}
+	// The median of three different keys leaves at least one arc on either side
+	arcKeyT samples[3] = {ArcKey(arcs[begin]), ArcKey(arcs[begin + (end - begin) / 2]), ArcKey(arcs[end - 1])};
+	sort(samples, samples + 3);
+	arcKeyT pivot = samples[1];
+	int middle = partition(arcs.begin() + begin, arcs.begin() + end, [pivot](arcT *arc){
+		return ArcKey(arc) <= pivot;
+	}) - arcs.begin();
+	FilterKruskal(run, arcs, begin, middle);
+	if(run.tree->arcs.size() >= run.treeSize) return;
+	int last = FilterArcs(run, arcs, middle, end);
+	FilterKruskal(run, arcs, middle, last);
+}
+
+void FilterKruskalSpanningTree(graphT &graph, spanningTreeT &tree, WorkerPool &pool){
+	int nodeCount = graph.nodeList.size();
+	tree.arcs.clear();
+	tree.distance = 0;
+	filterRunT run;
+	run.pool = &pool;
+	InitDisjointSet(run.sets, nodeCount);
+	run.tree = &tree;
+	run.treeSize = nodeCount - 1;
+	vector<arcT *> arcs;
+	arcs.reserve(graph.arcs.size());
+	for(int i = 0; i < graph.arcs.size(); i++)
+		arcs.push_back(graph.arcs[i]);
+	run.keep.resize(arcs.size());
+	FilterKruskal(run, arcs, 0, arcs.size());
+	tree.components = run.sets.sets;
+}
+
+/* Lowers *slot to key unless it is already lower */
+static inline void AtomicMin(atomic<arcKeyT> &slot, arcKeyT key){
+	arcKeyT current = slot.load(memory_order_relaxed);
+	while(key < current && !slot.compare_exchange_weak(current, key, memory_order_relaxed));
+}
+
+void BoruvkaSpanningTree(graphT &graph, spanningTreeT &tree, WorkerPool &pool){
+	int nodeCount = graph.nodeList.size();
+	tree.arcs.clear();
+	tree.distance = 0;
+	disjointSetT sets;
+	InitDisjointSet(sets, nodeCount);
+	vector<arcT *> active;  // arcs that may still be between two components
+	active.reserve(graph.arcs.size());
+	for(int i = 0; i < graph.arcs.size(); i++){
+		if(graph.arcs[i]->start != graph.arcs[i]->end) active.push_back(graph.arcs[i]);
+	}
+	vector<int> component(nodeCount);             // node id -> root of its component in this round
+	vector<atomic<arcKeyT> > shortest(nodeCount);  // root -> key of its shortest outgoing arc
+	vector<char> between(active.size());
+	while(!active.empty() && tree.arcs.size() < nodeCount - 1){
+		pool.parallelFor(nodeCount, NODE_CHUNK, [&](int i, int){
+			component[i] = FindSetReadOnly(sets, i);
+			shortest[i].store(NO_ARC_KEY, memory_order_relaxed);
+		});
+		pool.parallelFor(active.size(), ARC_CHUNK, [&](int i, int){
+			arcT *arc = active[i];
+			int from = component[arc->start->id], to = component[arc->end->id];
+			between[i] = (from != to);
+			if(from == to) return;
+			arcKeyT key = ArcKey(arc);
+			AtomicMin(shortest[from], key);
+			AtomicMin(shortest[to], key);
+		});
+		// Two components may pick the same arc; the second union fails, so it is added once
+		for(int i = 0; i < nodeCount; i++){
+			if(component[i] != i) continue;
+			arcKeyT key = shortest[i].load(memory_order_relaxed);
+			if(key != NO_ARC_KEY) TryArc(sets, tree, graph.arcs[(int)(key & 0xFFFFFFFFu)]);
+		}
+		int last = 0;
+		for(size_t i = 0; i < active.size(); i++){
+			if(between[i]) active[last++] = active[i];
+		}
+		active.resize(last);
+	}
+	tree.components = sets.sets;
+}
+
+/* Arc ids of the tree, sorted, to compare trees found in different orders */
+static vector<int> SortedArcIds(spanningTreeT &tree){
+	vector<int> ids;
+	for(int i = 0; i < tree.arcs.size(); i++)
+		ids.push_back(tree.arcs[i]->id);
+	sort(ids.begin(), ids.end());
+	return ids;
+}
+
+/* Seconds spent by engine 0 (filter-Kruskal) or 1 (Boruvka) on numThreads threads, checked against expected */
+static double TimeEngine(graphT &graph, int engine, int numThreads, spanningTreeT &expected){
+	WorkerPool pool(numThreads);
+	spanningTreeT tree;
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	if(engine == 0)
+		FilterKruskalSpanningTree(graph, tree, pool);
+	else
+		BoruvkaSpanningTree(graph, tree, pool);
+	double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	if(tree.distance != expected.distance || tree.components != expected.components
+	   || SortedArcIds(tree) != SortedArcIds(expected))
+		Error("BenchmarkSpanningTrees: different spanning tree from the parallel engine");
+	return seconds;
+}
+
+void BenchmarkSpanningTrees(graphT &graph, int maxThreads){
+	if(maxThreads < 1) maxThreads = 1;
+	spanningTreeT expected;
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	KruskalSpanningTree(graph, expected);
+	double sequential = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	cout << "Minimal spanning tree of " << graph.nodeList.size() << " nodes, " << graph.arcs.size() << " arcs, total "
+	     << expected.distance << endl;
+	cout << "Kruskal: " << 1000 * sequential << " ms" << endl;
+
+	const char *names[2] = {"Filter-Kruskal", "Boruvka"};
+	for(int engine = 0; engine < 2; engine++){
+		double single = 0;
+		for(int threads = 1; ; threads = (threads * 2 < maxThreads) ? threads * 2 : maxThreads){
+			double seconds = TimeEngine(graph, engine, threads, expected);
+			if(threads == 1) single = seconds;
+			cout << names[engine] << ", " << threads << " threads: " << 1000 * seconds << " ms, speedup "
+			     << (seconds > 0 ? single / seconds : 0) << " over 1 thread, "
+			     << (seconds > 0 ? sequential / seconds : 0) << " over Kruskal" << endl;
+			if(threads == maxThreads) break;
+		}
+	}
+}
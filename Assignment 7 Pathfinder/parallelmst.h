@@ -0,0 +1,55 @@
+/*
+ * File: parallelmst.h
+ * -------------------
+ * This module exports two minimal spanning tree engines for large graphs that spread their work over a WorkerPool.
+ *
+ * Filter-Kruskal (Osipov, Sanders and Singler) splits the arcs around a pivot, solves the light half first and
+ * then drops every heavy arc whose end points the light half already joined, before it sorts what is left. On
+ * graphs with many more arcs than nodes most arcs are dropped unsorted. The filter pass runs in parallel.
+ *
+ * Boruvka's algorithm works in rounds: every component picks its shortest outgoing arc, all picked arcs join the
+ * tree at once and at least halve the number of components. The search for the picked arcs runs in parallel over
+ * the arcs still between two components.
+ *
+ * Both engines break ties between equally long arcs by arc id, as KruskalSpanningTree does. With this order all
+ * arcs compare differently and the minimal spanning forest is unique, so every engine finds the same arcs, whatever
+ * the number of threads; only the order of tree.arcs differs.
+ */
+
+#ifndef _parallelmst_h
+#define _parallelmst_h
+
+#include "genlib.h"
+#include "pathgraph.h"
+#include "mst.h"
+#include "parallel.h"
+
+/*
+ * Function: FilterKruskalSpanningTree
+ * Usage: FilterKruskalSpanningTree(graph, tree, pool);
+ * ----------------------------------------------------
+ * Fills tree with the minimal spanning forest of the graph by filter-Kruskal, using the threads of pool. The arcs of
+ * tree are in increasing order of distance.
+ */
+void FilterKruskalSpanningTree(graphT &graph, spanningTreeT &tree, WorkerPool &pool);
+
+/*
+ * Function: BoruvkaSpanningTree
+ * Usage: BoruvkaSpanningTree(graph, tree, pool);
+ * ----------------------------------------------
+ * Fills tree with the minimal spanning forest of the graph by Boruvka's algorithm, using the threads of pool. The
+ * arcs of tree are in the order of the rounds that picked them.
+ */
+void BoruvkaSpanningTree(graphT &graph, spanningTreeT &tree, WorkerPool &pool);
+
+/*
+ * Function: BenchmarkSpanningTrees
+ * Usage: BenchmarkSpanningTrees(graph, maxThreads);
+ * -------------------------------------------------
+ * Computes the minimal spanning forest once with KruskalSpanningTree and then with both parallel engines on 1, 2,
+ * 4, ... up to maxThreads threads, and prints the time and speedup of each run. Reports an error with Error if an
+ * engine finds a different total distance or a different set of arcs.
+ */
+void BenchmarkSpanningTrees(graphT &graph, int maxThreads);
+
+#endif
@@ -10,6 +10,7 @@
 
 #include <iostream>
 #include <fstream>
+#include <cstdlib>
 #include "genlib.h"
 #include "simpio.h"
 #include "pqueue.h"  // This is a generic priority queue, requires client supplied comparison callback for client's data type 
@@ -18,7 +19,13 @@
 #include "graphics.h"
 #include "extgraph.h"
 #include "stack.h"
-#include "set.h"
+#include "pathgraph.h"
+#include "shortestpath.h"
+#include "query.h"
+#include "batch.h"
+#include "kshortest.h"
+#include "mst.h"
+#include "parallelmst.h"
 
 /* Constants */
 const double NODE_RADIUS = 0.06;   // in inch
@@ -27,19 +34,7 @@ const double TEXT_MARGIN = 0.05;
 const string DEFAULT_COLOR = "Black";
 const string HIGHLIGHT_COLOR = "Red";
 const double HIGHLIGHT_INTERVAL = 1;
-
-/* Data structure */
-struct nodeT;
-struct arcT{
-	int distance;  // distance between start and end node
-	nodeT *start, *end;
-};
-struct nodeT{
-	string name;
-	double x;
-	double y;
-	Vector<arcT *> arcs;
-};
+const int MAX_ALTERNATIVE_ROUTES = 20;
 
 struct pointT{
 		double x;
@@ -112,36 +107,12 @@ string GetNodeName(pointT &point, Map<nodeT *> &nodes){
  * arcs and nodes side by side.
  */
 
-void HandleData(ifstream &infile, Vector<arcT *> &arcs, Map<nodeT *> &nodes){
-	string text;
-	infile >> text; // Ideally this should be NODES
-	while(true){
-		string nodeName;
-		infile >> nodeName;  
-		if(nodeName == "ARCS") break; 
-		nodeT *node = new nodeT;
-		node->name = nodeName;
-		infile >> node->x >> node->y;
-		nodes.add(nodeName, node);
-		DrawNode(node, DEFAULT_COLOR);
-	}
-
-	// After this arcs will start
-	while(true){
-		string start;
-		infile >> start;
-		if(infile.fail()) break; 
-
-		string end;                                     // --------------------------------|
-		arcT *arc = new arcT;                           //                                 |
-		infile >> end >> arc->distance;                 //                                 |
-		arc->start = nodes.getValue(start);             //                                 |
-		arc->end = nodes.getValue(end);                 //                                 |
-		arc->start->arcs.add(arc);  // add this arc to the arcs of start node       Better not to decompose this code
-		arc->end->arcs.add(arc);	// add this arc to the arcs of end node
-		arcs.add(arc);                                  //                                 |
-		DrawArc(arc, DEFAULT_COLOR);                                   // --------------------------------|
-	}
+void HandleData(ifstream &infile, graphT &graph){
+	ReadGraph(infile, graph);
+	for(int i = 0; i < graph.nodeList.size(); i++)
+		DrawNode(graph.nodeList[i], DEFAULT_COLOR);
+	for(int i = 0; i < graph.arcs.size(); i++)
+		DrawArc(graph.arcs[i], DEFAULT_COLOR);
 }
 
 /* Function 1.2: DisplayImage
@@ -195,7 +166,7 @@ void SelectNodes(Vector<nodeT *> &endPoints, Map<nodeT *> &nodes){
  *               2. Read the data file and upload the data into the data structure.
  *               3. Display the graph on screen and enable all clicking functionality(to select a location by clicking)
  */
-void UploadNewGraph(Vector<arcT *> &arcs, Map<nodeT *> &nodes){
+void UploadNewGraph(graphT &graph){
 	ifstream in;
 	while(true){
 		cout << "Please enter name of graph data file: ";
@@ -205,7 +176,10 @@ void UploadNewGraph(Vector<arcT *> &arcs, Map<nodeT *> &nodes){
 			string imageName;
 			getline(in,imageName);
 			DisplayImage(imageName);
-			HandleData(in, arcs, nodes); 
+			FreeGraph(graph);  // forget the previous graph, if any
+			graph.fileName = filename;
+			HandleData(in, graph); 
+			CalibrateHeuristic(graph);
 			break;
 		}
 		else{
@@ -223,56 +197,13 @@ void UploadNewGraph(Vector<arcT *> &arcs, Map<nodeT *> &nodes){
 void GiveOptions(){
 	cout << "Your options are:" << endl;
 	cout << "           (1) Choose a new graph data file" << endl;
-    cout << "           (2) Find shortest path using Dijkstra's algorithm" << endl;
-	cout << "           (3) Compute the minimal spanning tree using Kruskal's algorithm" << endl;
-	cout << "           (4) Quit" << endl;
+    cout << "           (2) Find shortest path (Dijkstra's algorithm, A*, bidirectional, contraction hierarchy, landmarks or cached trees)" << endl;
+	cout << "           (3) Compute the minimal spanning tree" << endl;
+	cout << "           (4) Find alternative routes (k shortest paths)" << endl;
+	cout << "           (5) Quit" << endl;
 	cout << "Enter choice: ";  
 }
 
-/* Function 3.1: CmpBySuumedDistance
- * ------------------------
- * This function is the callback function for comparing different elements in the queue.
- * Here, since an element is represented by a stack of arcs, two stacks are compared based on the sum of distance of their arcs
- * The stack with less summed distance is given higher priority
- */
-int CmpBySummedDistance(Stack<arcT *> path1, Stack<arcT *> path2){
-	int sum1 = 0;
-	for(int i = 0; i < path1.size(); i++){
-		sum1 += path1.peek()->distance;
-		path1.pop();
-	}
-	int sum2 = 0;
-	for(int i = 0; i < path2.size(); i++){
-		sum2 += path2.peek()->distance;
-		path2.pop();
-	}
-	
-	if(sum1 < sum2)  // Because less sum higher priority
-		return 1;
-	else if(sum1 == sum2)
-		return 0;
-	else
-		return -1;
-}
-
-/* Function 3: GetNewPath
- * --------------------------
- * This function returns a new path to be added to the priority queue if the new possible arc 
- * has either of the end points not already visited and adds the two end points of new arc to the set 
- * of nodes visited. Returns empty path otherwise.
- */
-Stack<arcT *> GetNewPath(arcT * &possibleNewArc, Set<string> &nodesVisited, Stack<arcT *> &pathSoFar){
-	Stack<arcT *> newPath;
-	if(!(nodesVisited.contains(possibleNewArc->start->name)) ||  // if either of the endpoints of possible new 
-	!(nodesVisited.contains(possibleNewArc->end->name))){    // arc is not contained in nodesVisited
-		newPath = pathSoFar;
-		newPath.push(possibleNewArc);
-		nodesVisited.add(possibleNewArc->start->name);
-		nodesVisited.add(possibleNewArc->end->name);
-		return newPath;
-	}
-	return newPath;
-}
 /* Function: HighlightPath
  * -----------------------
  * This function highlights the path with the color passed as argument
@@ -286,55 +217,96 @@ void HighlightPath(Stack<arcT *> path, string color){
 		DrawArc(topArc, color);
 	}
 }
+/* Function 3.2: ChooseSearchMode
+ * -------------------------------
+ * This function asks the user which algorithm to use for finding the shortest path.
+ */
+searchModeT ChooseSearchMode(){
+	while(true){
+		cout << "Search with (1) Dijkstra's algorithm, (2) A* search, (3) bidirectional Dijkstra, "
+		     << "(4) contraction hierarchy, (5) A* with landmarks or (6) Dijkstra with cached trees? ";
+		string choice = GetLine();
+		if(choice == "1") return DIJKSTRA_SEARCH;
+		if(choice == "2") return ASTAR_SEARCH;
+		if(choice == "3") return BIDIRECTIONAL_SEARCH;
+		if(choice == "4") return HIERARCHY_SEARCH;
+		if(choice == "5") return LANDMARK_SEARCH;
+		if(choice == "6") return CACHED_TREE_SEARCH;
+		cout << "Invalid choice. Please enter a number between 1 and 6" << endl;
+	}
+}
+
 /* Function : GetShortestPath
  * --------------------------
- * This function returns the shortest route between the endpoints using Dijkstra's algorithm and returns the stack of nodenames 
- * that are involved in the path. Also prints the number of dequeues done to reach shortest path.
- * Assumes ending location is not the same as starting location.
+ * This function returns the shortest route between the endpoints using the selected algorithm and returns the stack of
+ * arcs that are involved in the path. Also prints the number of dequeues done to reach the shortest path, together
+ * with the other search counters. For the modes other than Dijkstra's algorithm it also prints the number of dequeues
+ * Dijkstra's algorithm needs for the same query, so that the savings can be compared. Returns an empty stack if the
+ * ending location cannot be reached from the starting location.
  */
-Stack<arcT *> GetShortestPath(Vector<nodeT *> &endPoints, Map<nodeT *> &nodes){
-	Stack<string> shortestPath; 
-	PQueue<Stack<arcT *> > pq(CmpBySummedDistance);
-	Set<string> nodesVisited;
-	// Handle the first search
-	for(int i = 0; i < endPoints[0]->arcs.size(); i++){
-		Stack<arcT* > emptyPath;
-		Stack<arcT *> newPath = GetNewPath(endPoints[0]->arcs[i], nodesVisited, emptyPath);
-		if(newPath.size() != 0)
-			pq.enqueue(newPath);
+Stack<arcT *> GetShortestPath(Vector<nodeT *> &endPoints, graphT &graph, searchModeT mode){
+	queryScratchT scratch;
+	Stack<arcT *> path;
+	int distance, dequeues;
+	searchStatsT stats;
+	if(!RunQuery(graph, mode, endPoints[0], endPoints[1], scratch, path, distance, dequeues, &stats)){
+		cout << "There is no path between the chosen locations." << endl;
+		return path;
 	}
-	int ndequeue = 0;
-	while(true){
-		Stack<arcT *> pathToCheck = pq.dequeueMax();
-		ndequeue++;
-		if(pathToCheck.peek()->end == endPoints[1] || pathToCheck.peek()->start == endPoints[1]){   // because arc is bidirectional
-			cout << "The algorithm dequeued " << ndequeue << " paths to find the optimal one." << endl;
-			return pathToCheck;
-		}
-		for(int i = 0; i < pathToCheck.peek()->start->arcs.size(); i++){
-			Stack<arcT *> newPath = GetNewPath(pathToCheck.peek()->start->arcs[i], nodesVisited, pathToCheck);
-			if(newPath.size() != 0)
-				pq.enqueue(newPath);
-		}
-		for(int i = 0; i < pathToCheck.peek()->end->arcs.size(); i++){
-			Stack<arcT *> newPath = GetNewPath(pathToCheck.peek()->end->arcs[i], nodesVisited, pathToCheck);
-			if(newPath.size() != 0)
-				pq.enqueue(newPath);			
-		}
+	cout << "The algorithm dequeued " << dequeues << " nodes to find the optimal path." << endl;
+	PrintSearchStats(stats, cout);
+	if(mode == CACHED_TREE_SEARCH)
+		PrintTreeCacheCounters(graph);
+	if(mode != DIJKSTRA_SEARCH){
+		Stack<arcT *> dijkstraPath;
+		int dijkstraDistance, dijkstraDequeues;
+		RunQuery(graph, DIJKSTRA_SEARCH, endPoints[0], endPoints[1], scratch, dijkstraPath, dijkstraDistance,
+		         dijkstraDequeues);
+		cout << "Dijkstra's algorithm dequeues " << dijkstraDequeues << " nodes for the same query." << endl;
 	}
+	cout << "The shortest path is " << distance << " long." << endl;
+	return path;
+}
+/* Function: PrepareHierarchy
+ * --------------------------
+ * This function loads or builds the contraction hierarchy before its first query, and reports the number of
+ * shortcuts if it had to be built.
+ */
+void PrepareHierarchy(graphT &graph){
+	if(graph.hierarchy != NULL) return;
+	cout << "Preparing the contraction hierarchy..." << endl;
+	contractionHierarchyT *ch = GetContractionHierarchy(graph);
+	if(ch->loaded) return;
+	cout << "Added " << ch->arcs.size() - ch->graphArcCount << " shortcuts." << endl;
+	if(graph.updates == 0 && !ch->saved)
+		cout << "Could not save the hierarchy to " << graph.fileName << ".ch" << endl;
 }
 /* Function 3: ShortestPath()
  * --------------------------
  * This function is a wrapper function around finding the shortest path
- * It first asks the user for selecting two endPoints, highlights it, uses djikstra's algorithm to get 
+ * It first asks the user for selecting two endPoints, highlights it, asks for the algorithm, uses it to get 
  * the shortest path joining those points and highlights the path.
  *
  */
-void ShortestPath(Map<nodeT *> &nodes){
+void ShortestPath(graphT &graph){
 	Vector<nodeT *> endPoints;
-	SelectNodes(endPoints, nodes);  // Asks user for two endpoints
-	cout<< "Finding shortest path using Djikstra's..." << endl;
-	Stack<arcT *> path= GetShortestPath(endPoints, nodes);
+	SelectNodes(endPoints, graph.nodes);  // Asks user for two endpoints
+	searchModeT mode = ChooseSearchMode();
+	if(mode == ASTAR_SEARCH)
+		cout<< "Finding shortest path using A*..." << endl;
+	else if(mode == BIDIRECTIONAL_SEARCH)
+		cout<< "Finding shortest path using bidirectional Djikstra's..." << endl;
+	else if(mode == HIERARCHY_SEARCH){
+		PrepareHierarchy(graph);
+		cout<< "Finding shortest path using the contraction hierarchy..." << endl;
+	}
+	else if(mode == LANDMARK_SEARCH)
+		cout<< "Finding shortest path using A* with landmarks..." << endl;
+	else if(mode == CACHED_TREE_SEARCH)
+		cout<< "Finding shortest path using the shortest path tree cache..." << endl;
+	else
+		cout<< "Finding shortest path using Djikstra's..." << endl;
+	Stack<arcT *> path= GetShortestPath(endPoints, graph, mode);
 	HighlightPath(path, HIGHLIGHT_COLOR);
 	cout << "Hit return to continue..." ;
 	GetLine();
@@ -343,45 +315,75 @@ void ShortestPath(Map<nodeT *> &nodes){
 	DrawNode(endPoints[1], DEFAULT_COLOR);
 }
 
-/* Function : CmpByDistance
- * ------------------------
- * This is the call back function for the peiority queue generated in minimal spanning tree.
- * The arc with shorter distance is given higher priority
+/* Function 4: AlternativeRoutes()
+ * --------------------------------
+ * This function asks the user for two endPoints and the number of routes wanted, finds that many shortest loopless
+ * routes between them and highlights them one after the other, shortest first.
  */
-int CmpByDistance(arcT *arc1, arcT *arc2){
-	if(arc1->distance < arc2->distance)
-		return 1;
-	else if (arc1->distance == arc2->distance)
-		return 0;
-	else
-		return -1;
+void AlternativeRoutes(graphT &graph){
+	Vector<nodeT *> endPoints;
+	SelectNodes(endPoints, graph.nodes);  // Asks user for two endpoints
+	int k;
+	while(true){
+		cout << "How many routes (1 to " << MAX_ALTERNATIVE_ROUTES << ")? ";
+		k = GetInteger();
+		if(k >= 1 && k <= MAX_ALTERNATIVE_ROUTES) break;
+		cout << "Please enter a number between 1 and " << MAX_ALTERNATIVE_ROUTES << endl;
+	}
+	kShortestStateT state;
+	Vector<rankedPathT> routes;
+	int found = FindKShortestPaths(graph, endPoints[0], endPoints[1], k, routes, state);
+	if(found == 0)
+		cout << "There is no path between the chosen locations." << endl;
+	else if(found < k)
+		cout << "There are only " << found << " loopless routes between the chosen locations." << endl;
+	cout << "The spur searches dequeued " << state.dequeues << " nodes in total." << endl;
+	for(int i = 0; i < found; i++){
+		cout << "Route " << i + 1 << " is " << routes[i].distance << " long. Hit return to continue..." ;
+		HighlightPath(routes[i].path, HIGHLIGHT_COLOR);
+		GetLine();
+		HighlightPath(routes[i].path, DEFAULT_COLOR);
+	}
+	DrawNode(endPoints[0], DEFAULT_COLOR);
+	DrawNode(endPoints[1], DEFAULT_COLOR);
 }
 
 /* Function: ComputeMinimalSpanningTree
  * ------------------------------------
  * This function is a wrapper around computing the minimal spanning tree. 
- * It finds the path joining the minimal spanning tree using Kruskal's algorithm and then highlights it.
+ * It picks the engine that suits the size and density of the graph, tells which one and why, finds the arcs of the
+ * minimal spanning tree with it and then highlights them.
  */
-void ComputeMinimalSpanningTree(Vector<arcT *> &arcs){
-	PQueue<arcT *> pq(CmpByDistance);
-	for(int i = 0; i < arcs.size(); i++)
-		pq.enqueue(arcs[i]);
-	Set<string> nodesVisited; 
-	Vector<arcT *> MinimalSpanningTree;  // Just for dehighighliting purpose
-	int distance = 0;
-	while(!pq.isEmpty()){
-		arcT *nextShortestArc = pq.dequeueMax();
-		cout << nextShortestArc->start->name <<"->" <<nextShortestArc->end->name << endl;
-		if(!(nodesVisited.contains(nextShortestArc->start->name)) || !(nodesVisited.contains(nextShortestArc->end->name))){
-			DrawArc(nextShortestArc, HIGHLIGHT_COLOR);
-			//DrawNode(nextShortestArc->start, HIGHLIGHT_COLOR);
-			//DrawNode(nextShortestArc->end, HIGHLIGHT_COLOR);
-			distance += nextShortestArc->distance;
-			nodesVisited.add(nextShortestArc->start->name);
-			nodesVisited.add(nextShortestArc->end->name);
-		}
+void ComputeMinimalSpanningTree(graphT &graph){
+	int numThreads = DefaultThreadCount();
+	string reason;
+	spanningTreeEngineT engine = ChooseSpanningTreeEngine(graph, numThreads, reason);
+	spanningTreeT tree;
+	if(engine == DENSE_PRIM_ENGINE){
+		cout << "Using Prim's algorithm with an array: " << reason << "." << endl;
+		DensePrimSpanningTree(graph, tree);
+	}
+	else if(engine == PRIM_ENGINE){
+		cout << "Using Prim's algorithm with a heap: " << reason << "." << endl;
+		PrimSpanningTree(graph, tree);
+	}
+	else if(engine == BORUVKA_ENGINE){
+		cout << "Using Boruvka's algorithm: " << reason << "." << endl;
+		WorkerPool pool(numThreads);
+		BoruvkaSpanningTree(graph, tree, pool);
+	}
+	else{
+		cout << "Using Kruskal's algorithm: " << reason << "." << endl;
+		KruskalSpanningTree(graph, tree);
+	}
+	for(int i = 0; i < tree.arcs.size(); i++){
+		arcT *arc = tree.arcs[i];
+		cout << arc->start->name << "->" << arc->end->name << endl;
+		DrawArc(arc, HIGHLIGHT_COLOR);
 	}
-	cout << "The minimal spanning tree is highlighted, the total distance is " << distance << endl;
+	if(tree.components > 1)
+		cout << "The graph is not connected, the spanning forest has " << tree.components << " trees." << endl;
+	cout << "The minimal spanning tree is highlighted, the total distance is " << tree.distance << endl;
 }
 
 
@@ -389,30 +391,51 @@ void ComputeMinimalSpanningTree(Vector<arcT *> &arcs){
 
 
 int main(){
+	// Headless batch mode, driven by an environment variable
+	const char *batchSettings = getenv(BATCH_VARIABLE.c_str());
+	if(batchSettings != NULL){
+		batchSettingsT settings;
+		if(!ParseBatchSettings(batchSettings, settings)){
+			cout << "Usage: " << BATCH_VARIABLE << "=\"<graph file> <query file> <output file> [<threads> [<mode 1-6> "
+			     << "[<stats file>]]]\"" << endl;
+			return 1;
+		}
+		return RunBatch(settings) ? 0 : 1;
+	}
+	const char *benchmarkSettings = getenv(BENCHMARK_VARIABLE.c_str());
+	if(benchmarkSettings != NULL){
+		if(!RunScalingBenchmark(benchmarkSettings)){
+			cout << "Usage: " << BENCHMARK_VARIABLE << "=\"<graph file> [<max threads> [<sources>]]\"" << endl;
+			return 1;
+		}
+		return 0;
+	}
+
 	// Datastructure
-	Vector<arcT *> arcs;
-	Map<nodeT *> nodes;
+	graphT graph;
 
-	UploadNewGraph(arcs, nodes);  
+	UploadNewGraph(graph);  
 	while(true){
 		GiveOptions();
 		string choice = GetLine();
 		
 		if(choice == "1"){
 			cout << endl;
-			UploadNewGraph(arcs, nodes);
+			UploadNewGraph(graph);
 		}
 		else if (choice == "2"){
-			ShortestPath(nodes);
+			ShortestPath(graph);
 		}
 		else if (choice == "3")
-			ComputeMinimalSpanningTree(arcs);
-		else if (choice == "4"){
+			ComputeMinimalSpanningTree(graph);
+		else if (choice == "4")
+			AlternativeRoutes(graph);
+		else if (choice == "5"){
 			cout << "Thanks for playing. Have a nice day!" << endl;
 			break;
 		}
 		else{
-			cout << "Invalid choice. Please enter a number between 1 and 4" << endl << endl;
+			cout << "Invalid choice. Please enter a number between 1 and 5" << endl << endl;
 		}
 
 	}
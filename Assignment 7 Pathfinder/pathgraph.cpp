@@ -0,0 +1,112 @@
+/*
+ * File: pathgraph.cpp
+ * -------------------
+ * This file implements the helpers that build and tear down the graph data structure.
+ */
+
+#include "pathgraph.h"
+#include "contraction.h"
+#include "landmarks.h"
+#include "treecache.h"
+
+/* Creates a new node with the next free id */
+nodeT *AddNode(graphT &graph, string name, double x, double y){
+	nodeT *node = new nodeT;
+	node->name = name;
+	node->x = x;
+	node->y = y;
+	node->id = graph.nodeList.size();
+	graph.nodeList.add(node);
+	graph.nodes.add(name, node);
+	return node;
+}
+
+/* Creates a new arc with the next free id and links it into both end points */
+arcT *AddArc(graphT &graph, nodeT *start, nodeT *end, int distance){
+	arcT *arc = new arcT;
+	arc->distance = distance;
+	arc->start = start;
+	arc->end = end;
+	arc->id = graph.arcs.size();
+	if(distance < 0) graph.negativeArcs++;
+	start->arcs.add(arc);  // add this arc to the arcs of start node
+	end->arcs.add(arc);    // add this arc to the arcs of end node
+	graph.arcs.add(arc);
+	return arc;
+}
+
+/* Reads the nodes up to the ARCS line, then the arcs up to the end of the file */
+void ReadGraph(ifstream &infile, graphT &graph){
+	string text;
+	infile >> text; // Ideally this should be NODES
+	while(true){
+		string nodeName;
+		infile >> nodeName;
+		if(nodeName == "ARCS" || infile.fail()) break;
+		double x, y;
+		infile >> x >> y;
+		AddNode(graph, nodeName, x, y);
+	}
+
+	// After this arcs will start
+	while(true){
+		string start;
+		infile >> start;
+		if(infile.fail()) break;
+
+		string end;
+		int distance;
+		infile >> end >> distance;
+		AddArc(graph, graph.nodes.getValue(start), graph.nodes.getValue(end), distance);
+	}
+}
+
+/*
+ * Sets the distance of the arc and keeps graph.negativeArcs counting the arcs below 0. The contraction hierarchy and
+ * the landmark table no longer hold for the new distance, so they are freed and rebuilt when next needed; the trees
+ * in the cache are repaired in place, and the heuristic scale is lowered if the arc got shorter.
+ */
+void UpdateArcDistance(graphT &graph, arcT *arc, int distance){
+	int oldDistance = arc->distance;
+	if(distance == oldDistance) return;
+	if(oldDistance < 0) graph.negativeArcs--;
+	if(distance < 0) graph.negativeArcs++;
+	arc->distance = distance;
+	graph.updates++;
+	delete graph.hierarchy;
+	graph.hierarchy = NULL;
+	FreeLandmarkTable(graph.landmarks);
+	graph.landmarks = NULL;
+	if(distance < oldDistance)
+		LowerHeuristicScale(graph, arc);
+	RepairCachedTrees(graph, arc, oldDistance);
+}
+
+/* Deletes every node and arc of the graph, and the data derived from them */
+void FreeGraph(graphT &graph){
+	delete graph.hierarchy;
+	graph.hierarchy = NULL;
+	FreeLandmarkTable(graph.landmarks);
+	graph.landmarks = NULL;
+	FreeTreeCache(graph.treeCache);
+	graph.treeCache = NULL;
+	for(int i = 0; i < graph.arcs.size(); i++)
+		delete graph.arcs[i];
+	for(int i = 0; i < graph.nodeList.size(); i++)
+		delete graph.nodeList[i];
+	graph.arcs.clear();
+	graph.nodeList.clear();
+	graph.nodes.clear();
+	graph.negativeArcs = 0;
+	graph.updates = 0;
+	graph.fileName = "";
+	graph.heuristicScale = 0;
+}
+
+/* Returns the sum of all arc distances */
+long long SumOfArcDistances(graphT &graph){
+	long long sum = 0;
+	for(int i = 0; i < graph.arcs.size(); i++)
+		sum += graph.arcs[i]->distance;
+	return sum;
+}
@@ -0,0 +1,124 @@
+/*
+ * File: pathgraph.h
+ * -----------------
+ * Defines the graph data structure shared by the pathfinder program and its search engines.
+ * Every node and arc carries a dense integer id (0 .. count-1) so that the search engines can keep
+ * their per-node bookkeeping in flat arrays instead of name keyed sets and maps.
+ */
+
+#ifndef _pathgraph_h
+#define _pathgraph_h
+
+#include <fstream>
+#include "genlib.h"
+#include "vector.h"
+#include "map.h"
+
+/* Data structure */
+struct nodeT;
+struct arcT{
+	int distance;  // distance between start and end node
+	nodeT *start, *end;
+	int id;        // index of this arc in graphT::arcs
+};
+struct nodeT{
+	string name;
+	double x;
+	double y;
+	Vector<arcT *> arcs;
+	int id;        // index of this node in graphT::nodeList
+};
+
+struct contractionHierarchyT;  // see contraction.h
+struct landmarkTableT;         // see landmarks.h
+struct treeCacheT;             // see treecache.h
+
+/*
+ * Type: graphT
+ * ------------
+ * The complete graph read from a data file. The same nodes are reachable by name (for the user interface) and by
+ * id (for the search engines). The graph also owns the preprocessed data derived from it, which FreeGraph discards
+ * together with the graph.
+ */
+struct graphT{
+	Map<nodeT *> nodes;        // name -> node
+	Vector<nodeT *> nodeList;  // id -> node
+	Vector<arcT *> arcs;       // id -> arc
+	int negativeArcs;          // number of arcs with a negative distance
+	string fileName;           // data file the graph was read from
+	double heuristicScale;     // lower bound of arc distance per unit of map length, see CalibrateHeuristic
+	contractionHierarchyT *hierarchy;  // NULL until GetContractionHierarchy loads or builds it
+	landmarkTableT *landmarks;         // NULL until GetLandmarkTable loads or builds it
+	treeCacheT *treeCache;             // NULL until GetTreeCache creates it
+	int updates;               // arc distances changed since the graph was read, see UpdateArcDistance
+
+	graphT() : negativeArcs(0), heuristicScale(0), hierarchy(NULL), landmarks(NULL), treeCache(NULL), updates(0) {}
+};
+
+/*
+ * Function: AddNode
+ * Usage: nodeT *node = AddNode(graph, name, x, y);
+ * ------------------------------------------------
+ * Creates a new node, gives it the next free id and adds it to the graph.
+ */
+nodeT *AddNode(graphT &graph, string name, double x, double y);
+
+/*
+ * Function: AddArc
+ * Usage: arcT *arc = AddArc(graph, start, end, distance);
+ * -------------------------------------------------------
+ * Creates a new arc between the two nodes, gives it the next free id and adds it to the graph as well as to the
+ * arc lists of both end points (arcs are bidirectional).
+ */
+arcT *AddArc(graphT &graph, nodeT *start, nodeT *end, int distance);
+
+/*
+ * Function: UpdateArcDistance
+ * Usage: UpdateArcDistance(graph, arc, distance);
+ * -----------------------------------------------
+ * Changes the distance of an arc in place, for closures and congestion. The cached shortest path trees are repaired
+ * (see RepairCachedTrees) and the heuristic scale is lowered if the arc needs it, both at a cost that depends on the
+ * part of the graph the change affects. The contraction hierarchy and the landmark tables cannot be repaired and are
+ * dropped; they are rebuilt in memory on next use, since the files next to the graph file describe the graph as it
+ * was read. Must not be called while queries are running.
+ */
+void UpdateArcDistance(graphT &graph, arcT *arc, int distance);
+
+/*
+ * Function: ReadGraph
+ * Usage: ReadGraph(infile, graph);
+ * --------------------------------
+ * Reads the NODES and ARCS sections of a graph data file into the graph. The stream must be positioned after the
+ * image name on the first line. Nothing is drawn, so this also works without a graphics window.
+ */
+void ReadGraph(ifstream &infile, graphT &graph);
+
+/*
+ * Function: FreeGraph
+ * Usage: FreeGraph(graph);
+ * ------------------------
+ * Deletes every node and arc of the graph and leaves it empty, ready for a new graph to be read.
+ */
+void FreeGraph(graphT &graph);
+
+/*
+ * Function: SumOfArcDistances
+ * Usage: long long sum = SumOfArcDistances(graph);
+ * ------------------------------------------------
+ * Returns the sum of the distances of all arcs. Files of preprocessed data store it, so that data built for another
+ * version of the graph can be recognised.
+ */
+long long SumOfArcDistances(graphT &graph);
+
+/*
+ * Function: OtherEnd
+ * Usage: nodeT *next = OtherEnd(arc, node);
+ * -----------------------------------------
+ * Returns the end point of the arc that is not the node passed as argument. Since every arc is stored in the arc
+ * lists of both its end points, this is how a search steps across an arc.
+ */
+inline nodeT *OtherEnd(arcT *arc, nodeT *node){
+	return (arc->start == node) ? arc->end : arc->start;
+}
+
+#endif
@@ -7,164 +7,302 @@
 #include "genlib.h"
 #include <iostream>
 #include "cmpfn.h"
+#include <cstdlib>
+#include <new>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <exception>
+#include "strutils.h"
+#if defined(_MSC_VER)
+#include <intrin.h>   // _BitScanReverse, _BitScanForward
+#include <malloc.h>   // _aligned_malloc
+#endif
+
+/*
+ * SIMD child selection of DaryHeap: AVX2 and SSE2 where the compiler targets them (SSE2 always does on x64), none
+ * with PQUEUE_NO_SIMD defined.
+ */
+#if !defined(PQUEUE_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define PQUEUE_SIMD_SSE2 1
+#include <emmintrin.h>
+#else
+#define PQUEUE_SIMD_SSE2 0
+#endif
+#if PQUEUE_SIMD_SSE2 && defined(__AVX2__)
+#define PQUEUE_SIMD_AVX2 1
+#include <immintrin.h>
+#else
+#define PQUEUE_SIMD_AVX2 0
+#endif
 
 /* Constructor */
-template<typename ElemType>
-PQueue<ElemType>::PQueue(int (*cmp)(ElemType, ElemType) = OperatorCmp){
-	comparator = cmp;
+template<typename ElemType, typename CompareType>
+PQueue<ElemType, CompareType>::PQueue(CompareType cmp) : comparator(cmp){
+}
+
+/* Builds the queue from all elements of a Vector */
+template<typename ElemType, typename CompareType>
+PQueue<ElemType, CompareType>::PQueue(Vector<ElemType> &elements, CompareType cmp, int numThreads) : comparator(cmp){
+	enqueueAll(elements, numThreads);
+}
+
+/* Builds the queue from all elements of an iterator range */
+template<typename ElemType, typename CompareType>
+template<typename IteratorType>
+PQueue<ElemType, CompareType>::PQueue(IteratorType first, IteratorType last, CompareType cmp, int numThreads)
+	: comparator(cmp){
+	enqueueAll(first, last, numThreads);
 }
 
 /* Destructor */
-template<typename ElemType>
-PQueue<ElemType>::~PQueue(){
+template<typename ElemType, typename CompareType>
+PQueue<ElemType, CompareType>::~PQueue(){
 }
 
 /* Checks if the queue is empty or not*/
-template<typename ElemType>
-bool PQueue<ElemType>::isEmpty(){
-	return heap.isEmpty();
+template<typename ElemType, typename CompareType>
+bool PQueue<ElemType, CompareType>::isEmpty(){
+	return heap.empty();
 }
 
 
 /* ========================= Enqueue level 1 decomposition ===================================== */
 /* Returns true if the passed node is root node of heap */
-template<typename ElemType>
-bool PQueue<ElemType>::isRoot(int node){
+template<typename ElemType, typename CompareType>
+bool PQueue<ElemType, CompareType>::isRoot(int node){
 	return node == 0;
 }
 /* Returns the index of parent node of the node passed as argument */
-template<typename ElemType>
-int PQueue<ElemType>::getParent(int node){
+template<typename ElemType, typename CompareType>
+int PQueue<ElemType, CompareType>::getParent(int node){
 	return (node - 1)/2;
 }
-/* Returns true if value at node1 is greater than value at node2. False otherwise. Assumes both node exist */
-template<typename ElemType>
-bool PQueue<ElemType>::compareNode(int node1, int node2){
-return comparator(heap.getAt(node1), heap.getAt(node2)) > 0;
-}
-/* Swaps the value at each node */
-template<typename ElemType>
-void PQueue<ElemType>::swap(int node1, int node2){
-	ElemType temp = heap.getAt(node1);
-	heap[node1] = heap[node2];
-	heap[node2] = temp;
+/* Returns true if element one has a higher priority than element two */
+template<typename ElemType, typename CompareType>
+bool PQueue<ElemType, CompareType>::higher(const ElemType &one, const ElemType &two){
+	return comparator(one, two) > 0;
 }
 
 /*
  * Member function: bubbleUp
  * -------------------------
  * Helper to enqueue funtion to help the bubble up operation. This operation moves the newElement add at the
- * last of heap to the appropriate position in heap. The behaviour is achieved by swapping the element with its parent
- * till it is either less than or equal to its parent.
+ * last of heap to the appropriate position in heap. The element is taken out, leaving a hole at focusNode; every
+ * parent of lower priority moves down into the hole, and the element is put into the hole where it stops. Each
+ * element on the way moves once, and the comparisons are the same as swapping the element up level by level.
  */
-template<typename ElemType>
-void PQueue<ElemType>::bubbleUp(int focusNode){
+template<typename ElemType, typename CompareType>
+void PQueue<ElemType, CompareType>::bubbleUp(int focusNode){
 	if(size() == 0)
 		Error("Empty heap");
-	if(isRoot(focusNode)) return;                    // Base case
-	int parentNode = getParent(focusNode);
-	if(!compareNode(focusNode, parentNode)) return;  // Base case
-
-	swap(focusNode, parentNode);
-	bubbleUp(parentNode);	                         // else
+	ElemType moving = std::move(heap[focusNode]);
+	while(!isRoot(focusNode)){
+		int parentNode = getParent(focusNode);
+		if(!higher(moving, heap[parentNode])) break;
+		heap[focusNode] = std::move(heap[parentNode]);
+		focusNode = parentNode;
+	}
+	heap[focusNode] = std::move(moving);
 }
 
 
 
-/* Enqueues new element to the priority queue*/
-template<typename ElemType>
-void PQueue<ElemType>::enqueue(ElemType newElement){
-	heap.insertAt(size(), newElement);
+/* Enqueues a copy of the new element to the priority queue*/
+template<typename ElemType, typename CompareType>
+void PQueue<ElemType, CompareType>::enqueue(const ElemType &newElement){
+	heap.push_back(newElement);
 	int focusNode = size() - 1;
 	bubbleUp(focusNode);   // Moves the new element at appropriate position in the heap.
 }
 
-/* ================================= dequeue max decomposition level 1============================
-/* Function: isLast
- * ----------------
- * Returns true if the argument node is last in the heap
- */
-template<typename ElemType>
-bool PQueue<ElemType>::isLast(int node){
-	int child = 2*node + 1;
-	return child > size() - 1 ;  // if child does not exist that means it is last
+/* Enqueues the new element to the priority queue, moving it in */
+template<typename ElemType, typename CompareType>
+void PQueue<ElemType, CompareType>::enqueue(ElemType &&newElement){
+	heap.push_back(std::move(newElement));
+	bubbleUp(size() - 1);
 }
 
-/* Function: getChildren
- * ---------------------
- * This function saves the index of children of parent node in the children vector (passed by reference for efficiency reasons)
- */
-template<typename ElemType>
-void PQueue<ElemType>::getChild(int parentNode, Vector<int> &children){
-	int child1 = 2*parentNode + 1;     // left child
-	int child2 = 2*(parentNode + 1);   // right child
-	if(child1 <= (size() - 1))
-		children.add(child1);    // add only if child exist
-	if(child2 <= (size() - 1))  // add only if child exist
-		children.add(child2);
+/* Enqueues a new element constructed in place from the arguments */
+template<typename ElemType, typename CompareType>
+template<typename... ArgTypes>
+void PQueue<ElemType, CompareType>::emplace(ArgTypes&&... args){
+	heap.emplace_back(std::forward<ArgTypes>(args)...);
+	bubbleUp(size() - 1);
+}
+
+/* Enqueues copies of all elements of a Vector */
+template<typename ElemType, typename CompareType>
+void PQueue<ElemType, CompareType>::enqueueAll(Vector<ElemType> &elements, int numThreads){
+	int firstAdded = size();
+	heap.reserve(firstAdded + elements.size());
+	for(int i = 0; i < elements.size(); i++)
+		heap.push_back(elements[i]);
+	restoreHeap(firstAdded, numThreads);
 }
+
+/* Enqueues copies of all elements of an iterator range */
+template<typename ElemType, typename CompareType>
+template<typename IteratorType>
+void PQueue<ElemType, CompareType>::enqueueAll(IteratorType first, IteratorType last, int numThreads){
+	int firstAdded = size();
+	heap.insert(heap.end(), first, last);
+	restoreHeap(firstAdded, numThreads);
+}
+
+/* ================================= dequeue max decomposition level 1============================ */
 /* Function: heapify
  * -----------------
  * This function rearrange the heap in its proper heap form. Concretely, it rearrange the root node to its 
- * apt position by comparing each parent with its child node and swapping till the parent is either the largest
- * or at the last node.
- */
-template<typename ElemType>
-void PQueue<ElemType>::heapify(int parentNode){
-	if(isLast(parentNode)) return;
-	Vector<int> children;   // Vector to store child indices.
-	getChild(parentNode, children);
-	if(children.size() > 1){   // if both child exist
-		if(compareNode(parentNode, children[0]) && compareNode(parentNode, children[1])) return;
-		
-		else if(compareNode(children[0] , children[1])){  // if left children is greater, swap and recur
-			swap(parentNode, children[0]);
-			heapify(children[0]);
+ * apt position by comparing each parent with its child node and moving till the parent is either the largest
+ * or at the last node. Like bubbleUp it works on a hole: the element is taken out, the chosen child moves up into
+ * the hole at each level, and the element goes into the hole where it stops. The choice at each level is the one
+ * the swapping version made: stop if the element beats both children (or its only child does not beat it),
+ * else go to the left child if it beats the right one and to the right child otherwise.
+ */
+template<typename ElemType, typename CompareType>
+void PQueue<ElemType, CompareType>::heapify(int parentNode){
+	int count = size();
+	ElemType moving = std::move(heap[parentNode]);
+	while(true){
+		int child1 = 2*parentNode + 1;     // left child
+		int child2 = 2*(parentNode + 1);   // right child
+		if(child1 >= count) break;         // parent is last
+		int next;
+		if(child2 < count){                // if both child exist
+			if(higher(moving, heap[child1]) && higher(moving, heap[child2])) break;
+			next = higher(heap[child1], heap[child2]) ? child1 : child2;
 		}
 		else{
-			swap(parentNode, children[1]);          // else swap with right children and recur.
-			heapify(children[1]);
+			if(!higher(heap[child1], moving)) break;
+			next = child1;
 		}
+		heap[parentNode] = std::move(heap[next]);
+		parentNode = next;
 	}
-	else{
-		if(compareNode(children[0], parentNode)){
-			swap(parentNode, children[0]);
-			heapify(children[0]);
-		}
+	heap[parentNode] = std::move(moving);
+}
+
+/* ================================= bulk build ============================ */
+/*
+ * Member function: restoreHeap
+ * ----------------------------
+ * Bubbling the k added elements up takes up to k * depth comparisons, a rebuild about 2n for the n elements in all.
+ */
+template<typename ElemType, typename CompareType>
+void PQueue<ElemType, CompareType>::restoreHeap(int firstAdded, int numThreads){
+	int count = size();
+	int depth = 0;
+	for(int nodes = count; nodes > 1; nodes /= 2)
+		depth++;
+	if((long long)(count - firstAdded) * depth < 2LL * count){
+		for(int node = firstAdded; node < count; node++)
+			bubbleUp(node);
+	}
+	else
+		buildHeap(numThreads);
+}
+
+/*
+ * Member function: buildHeap
+ * --------------------------
+ * Heapifies the parent nodes from the last one up to the root, so that both subtrees of a node are heaps by the
+ * time it is heapified. Most nodes are near the leaves and move down only a level or two, which makes the whole
+ * pass O(n). On several threads, the heap is cut below its top levels into at least four subtrees per thread; the
+ * subtrees share no node, so the threads take them from a shared counter and rebuild them independently, and then
+ * the top levels are heapified on the calling thread. A comparison that throws on a helper thread is thrown again on
+ * the calling thread.
+ */
+template<typename ElemType, typename CompareType>
+void PQueue<ElemType, CompareType>::buildHeap(int numThreads){
+	int count = size();
+	int topNodes = 0;   // the nodes above the subtrees, heapified last
+	if(numThreads > 1 && count >= PARALLEL_HEAPIFY_MIN){
+		int depth = 0;
+		while((1 << depth) < 4 * numThreads && (2 << depth) - 1 < count / 2)
+			depth++;
+		topNodes = (1 << depth) - 1;
+		int subtrees = 1 << depth;
+		std::atomic<int> next(0);
+		std::exception_ptr failure;   // first exception thrown by a comparison, thrown again once all threads stop
+		std::mutex failureLock;
+		auto work = [&](){
+			try{
+				for(int subtree = next++; subtree < subtrees; subtree = next++)
+					heapifySubtree(topNodes + subtree);
+			}
+			catch(...){
+				std::lock_guard<std::mutex> guard(failureLock);
+				if(!failure) failure = std::current_exception();
+				next = subtrees;
+			}
+		};
+		std::vector<std::thread> workers;
+		for(int t = 1; t < numThreads; t++)
+			workers.push_back(std::thread(work));
+		work();
+		for(size_t t = 0; t < workers.size(); t++)
+			workers[t].join();
+		if(failure) std::rethrow_exception(failure);
+	}
+	else
+		topNodes = count / 2;   // every parent node
+	for(int node = topNodes - 1; node >= 0; node--)
+		heapify(node);
+}
+
+/* Heapifies the parent nodes of the subtree under root, its lowest level first */
+template<typename ElemType, typename CompareType>
+void PQueue<ElemType, CompareType>::heapifySubtree(int root){
+	int parents = size() / 2;                   // the nodes that have a child
+	int levelStart = root, levelWidth = 1;      // the nodes of the subtree on one level are consecutive
+	while(2*levelStart + 1 < parents){          // go down to the lowest level that has parent nodes
+		levelStart = 2*levelStart + 1;
+		levelWidth *= 2;
+	}
+	while(true){
+		int levelEnd = (levelStart + levelWidth < parents) ? levelStart + levelWidth : parents;
+		for(int node = levelEnd - 1; node >= levelStart; node--)
+			heapify(node);
+		if(levelStart == root) break;
+		levelStart = (levelStart - 1) / 2;
+		levelWidth /= 2;
 	}
 }
 
 /* Dequeues the element with highest priority */
-template<typename ElemType>
-ElemType PQueue<ElemType>::dequeueMax(){
+template<typename ElemType, typename CompareType>
+ElemType PQueue<ElemType, CompareType>::dequeueMax(){
 	if(size() == 0)
 		Error("Empty heap!");
-	swap(0, size() - 1);  
-	ElemType maxElem = heap.getAt(size() - 1); // get the largest element 
-	heap.removeAt(size() - 1);   // remove the last element
-	if(size() != 0)
-		heapify(0);    // start heapifying from root node only if more elements exist
+	ElemType maxElem = std::move(heap[0]);  // move out the largest element
+	if(size() > 1){
+		heap[0] = std::move(heap.back());   // the last element fills the root and sinks from there
+		heap.pop_back();
+		heapify(0);
+	}
+	else
+		heap.pop_back();
 	return maxElem;
-	
 }
 
 /* Returns the size of queue*/
-template<typename ElemType>
-int PQueue<ElemType>::size(){
-	return heap.size();
+template<typename ElemType, typename CompareType>
+int PQueue<ElemType, CompareType>::size(){
+	return (int)heap.size();
 }
 
 /* Returns the memory used by current queue. Not usually part of class, only for some performance
  * evaluation purposes*/
-template<typename ElemType>
-int PQueue<ElemType>::bytesUsed(){
-	return sizeof(*this) + heap.bytesUsed();
+template<typename ElemType, typename CompareType>
+int PQueue<ElemType, CompareType>::bytesUsed(){
+	return sizeof(*this) + heap.capacity() * sizeof(ElemType);
 	
 }
 /* Returns the implementation name */
-template<typename ElemType>
-string PQueue<ElemType>::implementationName(){
-	return "Heap";
+template<typename ElemType, typename CompareType>
+string PQueue<ElemType, CompareType>::implementationName(){
+	return "Binary heap";
 }
 
 /*
@@ -174,8 +312,8 @@ string PQueue<ElemType>::implementationName(){
  * in order as a debugging aid to keeping track of the cell contents
  * and the pointers between them. It prints each cell in order
  */
-template<typename ElemType>
-void PQueue<ElemType>::printDebuggingInfo()
+template<typename ElemType, typename CompareType>
+void PQueue<ElemType, CompareType>::printDebuggingInfo()
 {
 	cout << "------------------ START DEBUG INFO ------------------" << endl;
 	cout << "Pqueue contains " << size() << " entries" << endl;
@@ -186,3 +324,1147 @@ void PQueue<ElemType>::printDebuggingInfo()
 }
 
 
+
+/* ================================= DaryHeap ================================= */
+/* Allocates storage for count elements, the second of them at a cache line boundary */
+template<typename ElemType>
+ElemType *HeapGroupAllocator<ElemType>::allocate(size_t count){
+	if(count > (size_t(-1) - CACHE_LINE_BYTES) / sizeof(ElemType))
+		throw std::bad_alloc();
+	size_t bytes = allocationBytes(count);
+	void *block;
+#if defined(_MSC_VER)
+	block = _aligned_malloc(bytes, CACHE_LINE_BYTES);
+#else
+	if(posix_memalign(&block, CACHE_LINE_BYTES, bytes) != 0) block = NULL;
+#endif
+	if(block == NULL)
+		throw std::bad_alloc();
+	return (ElemType *)((char *)block + shift());
+}
+
+/* Frees storage handed out by allocate */
+template<typename ElemType>
+void HeapGroupAllocator<ElemType>::deallocate(ElemType *elements, size_t /*count*/){
+	void *block = (char *)elements - shift();
+#if defined(_MSC_VER)
+	_aligned_free(block);
+#else
+	free(block);
+#endif
+}
+
+/* Bytes taken from the system for count elements */
+template<typename ElemType>
+size_t HeapGroupAllocator<ElemType>::allocationBytes(size_t count){
+	return (count == 0) ? 0 : count * sizeof(ElemType) + shift();
+}
+
+/* Distance from the start of the aligned block to the first element: one element short of a line boundary */
+template<typename ElemType>
+size_t HeapGroupAllocator<ElemType>::shift(){
+	return (CACHE_LINE_BYTES - sizeof(ElemType) % CACHE_LINE_BYTES) % CACHE_LINE_BYTES;
+}
+
+/*
+ * Function: LowestSetBit
+ * ----------------------
+ * Returns the position (0 .. 31) of the lowest set bit of value, which must not be 0.
+ */
+inline int LowestSetBit(unsigned int value){
+#if defined(_MSC_VER)
+	unsigned long index;
+	_BitScanForward(&index, value);
+	return (int)index;
+#elif defined(__GNUC__)
+	return __builtin_ctz(value);
+#else
+	int position = 0;
+	while((value & 1) == 0){
+		value >>= 1;
+		position++;
+	}
+	return position;
+#endif
+}
+
+/*
+ * Class: DaryChildSelector
+ * ------------------------
+ * Finds the child of highest priority in a full group of Arity children and returns its index in the group. This
+ * general version compares them one by one and keeps the first of equal children. The specializations below do the
+ * same for int keys under MaxFirst and MinFirst with SIMD compares.
+ */
+template <typename ElemType, typename CompareType, int Arity>
+struct DaryChildSelector{
+	static int select(const ElemType *group, CompareType &comparator){
+		int best = 0;
+		for(int i = 1; i < Arity; i++)
+			if(comparator(group[i], group[best]) > 0) best = i;
+		return best;
+	}
+	static string name(){
+		return "scalar";
+	}
+};
+
+#if PQUEUE_SIMD_SSE2
+/* Lane by lane maximum of two vectors of ints; SSE2 has no signed 32 bit max, so it is a compare and a blend */
+inline __m128i MaxInts(__m128i one, __m128i two){
+	__m128i greater = _mm_cmpgt_epi32(one, two);
+	return _mm_or_si128(_mm_and_si128(greater, one), _mm_andnot_si128(greater, two));
+}
+
+/* Sets every lane of keys to the largest of its four lanes */
+inline __m128i SpreadMax(__m128i keys){
+	keys = MaxInts(keys, _mm_shuffle_epi32(keys, _MM_SHUFFLE(2, 3, 0, 1)));
+	return MaxInts(keys, _mm_shuffle_epi32(keys, _MM_SHUFFLE(1, 0, 3, 2)));
+}
+
+/* Bit i set if lane i of one equals lane i of two */
+inline int EqualLanes(__m128i one, __m128i two){
+	return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(one, two)));
+}
+
+/*
+ * Function: FirstLargestInt
+ * -------------------------
+ * Returns the index of the first of Arity ints that equals their maximum, after xoring each one with flip. A flip
+ * of all ones turns the order round (~x is larger than ~y exactly when x is smaller than y, with no overflow), so
+ * the same code finds the first smallest int for MinFirst.
+ */
+template <int Arity>
+inline int FirstLargestInt(const int *group, int flip);
+
+template <>
+inline int FirstLargestInt<4>(const int *group, int flip){
+	__m128i keys = _mm_xor_si128(_mm_loadu_si128((const __m128i *)group), _mm_set1_epi32(flip));
+	return LowestSetBit(EqualLanes(keys, SpreadMax(keys)));
+}
+
+template <>
+inline int FirstLargestInt<8>(const int *group, int flip){
+#if PQUEUE_SIMD_AVX2
+	__m256i keys = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)group), _mm256_set1_epi32(flip));
+	__m256i largest = _mm256_max_epi32(keys, _mm256_permute2x128_si256(keys, keys, 1));
+	largest = _mm256_max_epi32(largest, _mm256_shuffle_epi32(largest, _MM_SHUFFLE(2, 3, 0, 1)));
+	largest = _mm256_max_epi32(largest, _mm256_shuffle_epi32(largest, _MM_SHUFFLE(1, 0, 3, 2)));
+	return LowestSetBit(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(keys, largest))));
+#else
+	__m128i low = _mm_xor_si128(_mm_loadu_si128((const __m128i *)group), _mm_set1_epi32(flip));
+	__m128i high = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(group + 4)), _mm_set1_epi32(flip));
+	__m128i largest = SpreadMax(MaxInts(low, high));
+	return LowestSetBit(EqualLanes(low, largest) | (EqualLanes(high, largest) << 4));
+#endif
+}
+
+/* Child selection for int keys: flip is 0 for MaxFirst and all ones for MinFirst */
+template <int Arity, int flip>
+struct IntChildSelector{
+	template <typename CompareType>
+	static int select(const int *group, CompareType &){
+		return FirstLargestInt<Arity>(group, flip);
+	}
+	static string name(){
+		return (PQUEUE_SIMD_AVX2 && Arity == 8) ? "AVX2" : "SSE2";
+	}
+};
+
+template <int Arity>
+struct DaryChildSelector<int, MaxFirst<int>, Arity> : IntChildSelector<Arity, 0> {};
+
+template <int Arity>
+struct DaryChildSelector<int, MinFirst<int>, Arity> : IntChildSelector<Arity, -1> {};
+#endif
+
+/* Constructor */
+template<typename ElemType, typename CompareType, int Arity>
+DaryHeap<ElemType, CompareType, Arity>::DaryHeap(CompareType cmp) : comparator(cmp){
+}
+
+/* Destructor */
+template<typename ElemType, typename CompareType, int Arity>
+DaryHeap<ElemType, CompareType, Arity>::~DaryHeap(){
+}
+
+/* Checks if the queue is empty or not*/
+template<typename ElemType, typename CompareType, int Arity>
+bool DaryHeap<ElemType, CompareType, Arity>::isEmpty(){
+	return heap.empty();
+}
+
+/* Returns the size of queue*/
+template<typename ElemType, typename CompareType, int Arity>
+int DaryHeap<ElemType, CompareType, Arity>::size(){
+	return (int)heap.size();
+}
+
+/* Returns true if element one has a higher priority than element two */
+template<typename ElemType, typename CompareType, int Arity>
+bool DaryHeap<ElemType, CompareType, Arity>::higher(const ElemType &one, const ElemType &two){
+	return comparator(one, two) > 0;
+}
+
+/*
+ * Member function: bubbleUp
+ * -------------------------
+ * Same as PQueue::bubbleUp, with the parent of node k at (k - 1) / Arity: parents of lower priority move down into
+ * the hole the element leaves, and the element goes into the hole where it stops.
+ */
+template<typename ElemType, typename CompareType, int Arity>
+void DaryHeap<ElemType, CompareType, Arity>::bubbleUp(int focusNode){
+	ElemType moving = std::move(heap[focusNode]);
+	while(focusNode > 0){
+		int parentNode = (focusNode - 1) / Arity;
+		if(!higher(moving, heap[parentNode])) break;
+		heap[focusNode] = std::move(heap[parentNode]);
+		focusNode = parentNode;
+	}
+	heap[focusNode] = std::move(moving);
+}
+
+/* Returns the index of the child of highest priority among the count children from firstChild on */
+template<typename ElemType, typename CompareType, int Arity>
+int DaryHeap<ElemType, CompareType, Arity>::bestChild(int firstChild, int count){
+	if(count == Arity)
+		return firstChild + DaryChildSelector<ElemType, CompareType, Arity>::select(&heap[firstChild], comparator);
+	int best = firstChild;   // the last group of the heap may be short
+	for(int i = firstChild + 1; i < firstChild + count; i++)
+		if(higher(heap[i], heap[best])) best = i;
+	return best;
+}
+
+/*
+ * Member function: heapify
+ * ------------------------
+ * Moves the element at parentNode down like PQueue::heapify: at each level the best child of the group below the
+ * hole moves up into it, till no child has a higher priority than the element, which then fills the hole.
+ */
+template<typename ElemType, typename CompareType, int Arity>
+void DaryHeap<ElemType, CompareType, Arity>::heapify(int parentNode){
+	int count = size();
+	ElemType moving = std::move(heap[parentNode]);
+	while(true){
+		int firstChild = Arity * parentNode + 1;
+		if(firstChild >= count) break;     // parent is a leaf
+		int children = (count - firstChild < Arity) ? count - firstChild : Arity;
+		int next = bestChild(firstChild, children);
+		if(!higher(heap[next], moving)) break;
+		heap[parentNode] = std::move(heap[next]);
+		parentNode = next;
+	}
+	heap[parentNode] = std::move(moving);
+}
+
+/* Enqueues a copy of the new element to the priority queue*/
+template<typename ElemType, typename CompareType, int Arity>
+void DaryHeap<ElemType, CompareType, Arity>::enqueue(const ElemType &newElement){
+	heap.push_back(newElement);
+	bubbleUp(size() - 1);
+}
+
+/* Enqueues the new element to the priority queue, moving it in */
+template<typename ElemType, typename CompareType, int Arity>
+void DaryHeap<ElemType, CompareType, Arity>::enqueue(ElemType &&newElement){
+	heap.push_back(std::move(newElement));
+	bubbleUp(size() - 1);
+}
+
+/* Enqueues a new element constructed in place from the arguments */
+template<typename ElemType, typename CompareType, int Arity>
+template<typename... ArgTypes>
+void DaryHeap<ElemType, CompareType, Arity>::emplace(ArgTypes&&... args){
+	heap.emplace_back(std::forward<ArgTypes>(args)...);
+	bubbleUp(size() - 1);
+}
+
+/* Dequeues the element with highest priority */
+template<typename ElemType, typename CompareType, int Arity>
+ElemType DaryHeap<ElemType, CompareType, Arity>::dequeueMax(){
+	if(size() == 0)
+		Error("Empty heap!");
+	ElemType maxElem = std::move(heap[0]);
+	if(size() > 1){
+		heap[0] = std::move(heap.back());
+		heap.pop_back();
+		heapify(0);
+	}
+	else
+		heap.pop_back();
+	return maxElem;
+}
+
+/* Returns the memory used by current queue, the alignment slack included */
+template<typename ElemType, typename CompareType, int Arity>
+int DaryHeap<ElemType, CompareType, Arity>::bytesUsed(){
+	return sizeof(*this) + HeapGroupAllocator<ElemType>::allocationBytes(heap.capacity());
+}
+
+/* Returns the implementation name, such as "4-ary heap, SSE2 child selection" */
+template<typename ElemType, typename CompareType, int Arity>
+string DaryHeap<ElemType, CompareType, Arity>::implementationName(){
+	return IntegerToString(Arity) + "-ary heap, " + DaryChildSelector<ElemType, CompareType, Arity>::name()
+	       + " child selection";
+}
+
+/* Prints the heap contents in level order, one level per line */
+template<typename ElemType, typename CompareType, int Arity>
+void DaryHeap<ElemType, CompareType, Arity>::printDebuggingInfo()
+{
+	cout << "------------------ START DEBUG INFO ------------------" << endl;
+	cout << "Pqueue contains " << size() << " entries" << endl;
+	for (int levelStart = 0, levelSize = 1; levelStart < size(); levelStart += levelSize, levelSize *= Arity) {
+		for (int i = levelStart; i < levelStart + levelSize && i < size(); i++)
+			cout << heap[i] << " ";
+		cout << endl;
+	}
+	cout << "------------------ END DEBUG INFO ------------------" << endl;
+}
+
+
+/* ================================= NodePool ================================= */
+/* Returns the index of an unused node, the last released one if any */
+template<typename NodeType>
+int NodePool<NodeType>::allocate(){
+	int index;
+	if(freeNodes.empty()){
+		index = (int)nodes.size();
+		nodes.push_back(NodeType());
+		used.push_back(true);
+	}
+	else{
+		index = freeNodes.back();
+		freeNodes.pop_back();
+		used[index] = true;
+	}
+	return index;
+}
+
+/* Gives the node back to the pool */
+template<typename NodeType>
+void NodePool<NodeType>::release(int index){
+	used[index] = false;
+	freeNodes.push_back(index);
+}
+
+/* Returns true if index is a node handed out and not released */
+template<typename NodeType>
+bool NodePool<NodeType>::isUsed(int index){
+	return index >= 0 && index < (int)used.size() && used[index];
+}
+
+/* Returns the memory used by the nodes and the free list */
+template<typename NodeType>
+int NodePool<NodeType>::bytesUsed(){
+	return sizeof(*this) + nodes.capacity() * sizeof(NodeType) + used.capacity() / 8
+	       + freeNodes.capacity() * sizeof(int);
+}
+
+/* ================================= PairingHeap ================================= */
+/* Constructor */
+template<typename ElemType, typename CompareType>
+PairingHeap<ElemType, CompareType>::PairingHeap(CompareType cmp) : comparator(cmp){
+	root = NO_NODE;
+	count = 0;
+}
+
+/* Destructor */
+template<typename ElemType, typename CompareType>
+PairingHeap<ElemType, CompareType>::~PairingHeap(){
+}
+
+/* Checks if the queue is empty or not*/
+template<typename ElemType, typename CompareType>
+bool PairingHeap<ElemType, CompareType>::isEmpty(){
+	return count == 0;
+}
+
+/* Returns the size of queue*/
+template<typename ElemType, typename CompareType>
+int PairingHeap<ElemType, CompareType>::size(){
+	return count;
+}
+
+/* Returns true if element one has a higher priority than element two */
+template<typename ElemType, typename CompareType>
+bool PairingHeap<ElemType, CompareType>::higher(const ElemType &one, const ElemType &two){
+	return comparator(one, two) > 0;
+}
+
+/* Makes the root of lower priority the first child of the other and returns the new root; the first wins ties */
+template<typename ElemType, typename CompareType>
+int PairingHeap<ElemType, CompareType>::meld(int one, int two){
+	if(one == NO_NODE) return two;
+	if(two == NO_NODE) return one;
+	if(higher(nodes[two].element, nodes[one].element)){
+		int temp = one;
+		one = two;
+		two = temp;
+	}
+	nodeT &parent = nodes[one];
+	nodeT &child = nodes[two];
+	child.sibling = parent.child;
+	if(parent.child != NO_NODE)
+		nodes[parent.child].prev = two;
+	child.prev = one;
+	parent.child = two;
+	parent.sibling = parent.prev = NO_NODE;
+	return one;
+}
+
+/* Unlinks the subtree under node from its parent and siblings */
+template<typename ElemType, typename CompareType>
+void PairingHeap<ElemType, CompareType>::cut(int node){
+	nodeT &cutNode = nodes[node];
+	if(nodes[cutNode.prev].child == node)   // a first child: prev is the parent
+		nodes[cutNode.prev].child = cutNode.sibling;
+	else
+		nodes[cutNode.prev].sibling = cutNode.sibling;
+	if(cutNode.sibling != NO_NODE)
+		nodes[cutNode.sibling].prev = cutNode.prev;
+	cutNode.sibling = cutNode.prev = NO_NODE;
+}
+
+/* Reports an error if the handle is not in the queue */
+template<typename ElemType, typename CompareType>
+void PairingHeap<ElemType, CompareType>::checkHandle(int handle, string operation){
+	if(!contains(handle))
+		Error(operation + ": handle is not in the queue");
+}
+
+/* Enqueues the new element as a tree of one node melded with the root */
+template<typename ElemType, typename CompareType>
+int PairingHeap<ElemType, CompareType>::enqueue(ElemType newElement){
+	int node = nodes.allocate();
+	nodeT &added = nodes[node];
+	added.element = std::move(newElement);
+	added.child = added.sibling = added.prev = NO_NODE;
+	root = meld(root, node);
+	count++;
+	return node;
+}
+
+/*
+ * Member function: dequeueMax
+ * ---------------------------
+ * Removes the root and melds its children back into one tree in two passes: the first melds them in pairs from
+ * left to right, the second melds the pairs into the last one, from right to left. The two passes are what keeps
+ * the trees shallow enough for the O(log n) amortized bound; melding the children one after the other would not.
+ */
+template<typename ElemType, typename CompareType>
+ElemType PairingHeap<ElemType, CompareType>::dequeueMax(){
+	if(count == 0)
+		Error("Empty heap!");
+	int oldRoot = root;
+	ElemType maxElem = std::move(nodes[oldRoot].element);
+	pairs.clear();
+	int child = nodes[oldRoot].child;
+	while(child != NO_NODE){
+		int second = nodes[child].sibling;
+		int next = (second == NO_NODE) ? NO_NODE : nodes[second].sibling;
+		nodes[child].sibling = nodes[child].prev = NO_NODE;
+		if(second != NO_NODE)
+			nodes[second].sibling = nodes[second].prev = NO_NODE;
+		pairs.push_back(meld(child, second));
+		child = next;
+	}
+	root = NO_NODE;
+	for(int i = (int)pairs.size() - 1; i >= 0; i--)
+		root = meld(pairs[i], root);
+	nodes.release(oldRoot);
+	count--;
+	return maxElem;
+}
+
+/* Returns the element with highest priority without dequeuing it */
+template<typename ElemType, typename CompareType>
+ElemType PairingHeap<ElemType, CompareType>::peekMax(){
+	if(count == 0)
+		Error("Empty heap!");
+	return nodes[root].element;
+}
+
+/* Returns true if the handle refers to an element currently in the queue */
+template<typename ElemType, typename CompareType>
+bool PairingHeap<ElemType, CompareType>::contains(int handle){
+	return nodes.isUsed(handle);
+}
+
+/* Returns the element stored under the handle */
+template<typename ElemType, typename CompareType>
+ElemType PairingHeap<ElemType, CompareType>::getElement(int handle){
+	checkHandle(handle, "getElement");
+	return nodes[handle].element;
+}
+
+/* Gives the element a higher priority: its subtree is cut out and melded with the root */
+template<typename ElemType, typename CompareType>
+void PairingHeap<ElemType, CompareType>::increaseKey(int handle, ElemType newElement){
+	checkHandle(handle, "increaseKey");
+	if(higher(nodes[handle].element, newElement))
+		Error("increaseKey: new element has a lower priority");
+	nodes[handle].element = std::move(newElement);
+	if(handle == root) return;
+	cut(handle);
+	root = meld(root, handle);
+}
+
+/* Returns the memory used by current queue */
+template<typename ElemType, typename CompareType>
+int PairingHeap<ElemType, CompareType>::bytesUsed(){
+	return sizeof(*this) - sizeof(nodes) + nodes.bytesUsed() + pairs.capacity() * sizeof(int);
+}
+
+/* Returns the implementation name */
+template<typename ElemType, typename CompareType>
+string PairingHeap<ElemType, CompareType>::implementationName(){
+	return "Pairing heap";
+}
+
+/* Prints the tree in preorder, the children of a node in brackets after it */
+template<typename ElemType, typename CompareType>
+void PairingHeap<ElemType, CompareType>::printDebuggingInfo()
+{
+	cout << "------------------ START DEBUG INFO ------------------" << endl;
+	cout << "Pqueue contains " << size() << " entries" << endl;
+	std::vector<int> open;   // nodes still to print, NO_NODE for a closing bracket
+	if (root != NO_NODE) open.push_back(root);
+	while (!open.empty()) {
+		int node = open.back();
+		open.pop_back();
+		if (node == NO_NODE) {
+			cout << ") ";
+			continue;
+		}
+		cout << nodes[node].element << " ";
+		if (nodes[node].sibling != NO_NODE) open.push_back(nodes[node].sibling);
+		if (nodes[node].child != NO_NODE) {
+			cout << "( ";
+			open.push_back(NO_NODE);
+			open.push_back(nodes[node].child);
+		}
+	}
+	cout << endl;
+	cout << "------------------ END DEBUG INFO ------------------" << endl;
+}
+
+/* ================================= FibonacciHeap ================================= */
+/* Constructor */
+template<typename ElemType, typename CompareType>
+FibonacciHeap<ElemType, CompareType>::FibonacciHeap(CompareType cmp) : comparator(cmp){
+	top = NO_NODE;
+	count = 0;
+}
+
+/* Destructor */
+template<typename ElemType, typename CompareType>
+FibonacciHeap<ElemType, CompareType>::~FibonacciHeap(){
+}
+
+/* Checks if the queue is empty or not*/
+template<typename ElemType, typename CompareType>
+bool FibonacciHeap<ElemType, CompareType>::isEmpty(){
+	return count == 0;
+}
+
+/* Returns the size of queue*/
+template<typename ElemType, typename CompareType>
+int FibonacciHeap<ElemType, CompareType>::size(){
+	return count;
+}
+
+/* Returns true if element one has a higher priority than element two */
+template<typename ElemType, typename CompareType>
+bool FibonacciHeap<ElemType, CompareType>::higher(const ElemType &one, const ElemType &two){
+	return comparator(one, two) > 0;
+}
+
+/* Inserts node into the circular list to the right of anchor */
+template<typename ElemType, typename CompareType>
+void FibonacciHeap<ElemType, CompareType>::splice(int node, int anchor){
+	int after = nodes[anchor].right;
+	nodes[node].left = anchor;
+	nodes[node].right = after;
+	nodes[anchor].right = node;
+	nodes[after].left = node;
+}
+
+/* Removes node from its circular list, leaving it a list of its own */
+template<typename ElemType, typename CompareType>
+void FibonacciHeap<ElemType, CompareType>::unlink(int node){
+	nodes[nodes[node].left].right = nodes[node].right;
+	nodes[nodes[node].right].left = nodes[node].left;
+	nodes[node].left = nodes[node].right = node;
+}
+
+/* Makes the tree under child, already out of the list of trees, a child of parent */
+template<typename ElemType, typename CompareType>
+void FibonacciHeap<ElemType, CompareType>::link(int child, int parent){
+	nodeT &parentNode = nodes[parent];
+	if(parentNode.child == NO_NODE)
+		parentNode.child = child;
+	else
+		splice(child, parentNode.child);
+	nodes[child].parent = parent;
+	nodes[child].marked = false;
+	parentNode.degree++;
+}
+
+/* Moves the tree under node from its parent to the list of trees */
+template<typename ElemType, typename CompareType>
+void FibonacciHeap<ElemType, CompareType>::cut(int node){
+	int parent = nodes[node].parent;
+	nodeT &parentNode = nodes[parent];
+	if(parentNode.child == node)
+		parentNode.child = (nodes[node].right == node) ? NO_NODE : nodes[node].right;
+	unlink(node);
+	parentNode.degree--;
+	splice(node, top);
+	nodes[node].parent = NO_NODE;
+	nodes[node].marked = false;
+}
+
+/*
+ * Member function: consolidate
+ * ----------------------------
+ * Links trees of equal degree, the one of lower priority under the other, till no two trees have the same degree.
+ * byDegree holds the tree found so far for each degree; a tree that meets one of its degree is linked with it and
+ * goes on at the next degree. The trees that remain are put back into one list and the top is the highest of them.
+ */
+template<typename ElemType, typename CompareType>
+void FibonacciHeap<ElemType, CompareType>::consolidate(){
+	trees.clear();
+	int start = top;
+	int tree = start;
+	do{
+		trees.push_back(tree);
+		tree = nodes[tree].right;
+	}while(tree != start);
+	for(size_t i = 0; i < trees.size(); i++){
+		int current = trees[i];
+		nodes[current].left = nodes[current].right = current;
+		int degree = nodes[current].degree;
+		while(degree < (int)byDegree.size() && byDegree[degree] != NO_NODE){
+			int other = byDegree[degree];
+			byDegree[degree] = NO_NODE;
+			if(higher(nodes[other].element, nodes[current].element)){
+				int temp = current;
+				current = other;
+				other = temp;
+			}
+			link(other, current);
+			degree++;
+		}
+		if(degree >= (int)byDegree.size())
+			byDegree.resize(degree + 1, NO_NODE);
+		byDegree[degree] = current;
+	}
+	top = NO_NODE;
+	for(size_t degree = 0; degree < byDegree.size(); degree++){
+		int current = byDegree[degree];
+		if(current == NO_NODE) continue;
+		byDegree[degree] = NO_NODE;
+		if(top == NO_NODE)
+			top = current;
+		else{
+			splice(current, top);
+			if(higher(nodes[current].element, nodes[top].element))
+				top = current;
+		}
+	}
+}
+
+/* Reports an error if the handle is not in the queue */
+template<typename ElemType, typename CompareType>
+void FibonacciHeap<ElemType, CompareType>::checkHandle(int handle, string operation){
+	if(!contains(handle))
+		Error(operation + ": handle is not in the queue");
+}
+
+/* Enqueues the new element as a tree of one node in the list of trees */
+template<typename ElemType, typename CompareType>
+int FibonacciHeap<ElemType, CompareType>::enqueue(ElemType newElement){
+	int node = nodes.allocate();
+	nodeT &added = nodes[node];
+	added.element = std::move(newElement);
+	added.parent = added.child = NO_NODE;
+	added.left = added.right = node;
+	added.degree = 0;
+	added.marked = false;
+	if(top == NO_NODE)
+		top = node;
+	else{
+		splice(node, top);
+		if(higher(nodes[node].element, nodes[top].element))
+			top = node;
+	}
+	count++;
+	return node;
+}
+
+/* Dequeues the top: its children join the list of trees, which is then consolidated */
+template<typename ElemType, typename CompareType>
+ElemType FibonacciHeap<ElemType, CompareType>::dequeueMax(){
+	if(count == 0)
+		Error("Empty heap!");
+	int oldTop = top;
+	ElemType maxElem = std::move(nodes[oldTop].element);
+	int child = nodes[oldTop].child;
+	if(child != NO_NODE){
+		do{
+			nodes[child].parent = NO_NODE;
+			child = nodes[child].right;
+		}while(child != nodes[oldTop].child);
+		// Join the circular list of children to the list of trees in one step
+		int rightOfTop = nodes[oldTop].right;
+		int lastChild = nodes[child].left;
+		nodes[oldTop].right = child;
+		nodes[child].left = oldTop;
+		nodes[lastChild].right = rightOfTop;
+		nodes[rightOfTop].left = lastChild;
+	}
+	top = (nodes[oldTop].right == oldTop) ? NO_NODE : nodes[oldTop].right;
+	unlink(oldTop);
+	nodes.release(oldTop);
+	count--;
+	if(top != NO_NODE)
+		consolidate();
+	return maxElem;
+}
+
+/* Returns the element with highest priority without dequeuing it */
+template<typename ElemType, typename CompareType>
+ElemType FibonacciHeap<ElemType, CompareType>::peekMax(){
+	if(count == 0)
+		Error("Empty heap!");
+	return nodes[top].element;
+}
+
+/* Returns true if the handle refers to an element currently in the queue */
+template<typename ElemType, typename CompareType>
+bool FibonacciHeap<ElemType, CompareType>::contains(int handle){
+	return nodes.isUsed(handle);
+}
+
+/* Returns the element stored under the handle */
+template<typename ElemType, typename CompareType>
+ElemType FibonacciHeap<ElemType, CompareType>::getElement(int handle){
+	checkHandle(handle, "getElement");
+	return nodes[handle].element;
+}
+
+/*
+ * Member function: increaseKey
+ * ----------------------------
+ * Gives the element a higher priority. If it now beats its parent, it is cut out to the list of trees, and so is
+ * every marked ancestor above it; the first unmarked one gets marked, unless it is a root.
+ */
+template<typename ElemType, typename CompareType>
+void FibonacciHeap<ElemType, CompareType>::increaseKey(int handle, ElemType newElement){
+	checkHandle(handle, "increaseKey");
+	if(higher(nodes[handle].element, newElement))
+		Error("increaseKey: new element has a lower priority");
+	nodes[handle].element = std::move(newElement);
+	int parent = nodes[handle].parent;
+	if(parent != NO_NODE && higher(nodes[handle].element, nodes[parent].element)){
+		cut(handle);
+		while(nodes[parent].parent != NO_NODE){
+			if(!nodes[parent].marked){
+				nodes[parent].marked = true;
+				break;
+			}
+			int grandparent = nodes[parent].parent;
+			cut(parent);
+			parent = grandparent;
+		}
+	}
+	if(higher(nodes[handle].element, nodes[top].element))
+		top = handle;
+}
+
+/* Returns the memory used by current queue */
+template<typename ElemType, typename CompareType>
+int FibonacciHeap<ElemType, CompareType>::bytesUsed(){
+	return sizeof(*this) - sizeof(nodes) + nodes.bytesUsed() + (trees.capacity() + byDegree.capacity()) * sizeof(int);
+}
+
+/* Returns the implementation name */
+template<typename ElemType, typename CompareType>
+string FibonacciHeap<ElemType, CompareType>::implementationName(){
+	return "Fibonacci heap";
+}
+
+/* Prints each tree in preorder, the children of a node in brackets after it */
+template<typename ElemType, typename CompareType>
+void FibonacciHeap<ElemType, CompareType>::printDebuggingInfo()
+{
+	cout << "------------------ START DEBUG INFO ------------------" << endl;
+	cout << "Pqueue contains " << size() << " entries" << endl;
+	std::vector<int> open;   // lists still to print by their first node, NO_NODE for a closing bracket
+	std::vector<int> first;  // the node each list in open started from
+	if (top != NO_NODE) {
+		open.push_back(top);
+		first.push_back(top);
+	}
+	while (!open.empty()) {
+		int node = open.back();
+		int start = first.back();
+		open.pop_back();
+		first.pop_back();
+		if (node == NO_NODE) {
+			cout << ") ";
+			continue;
+		}
+		cout << nodes[node].element << (nodes[node].marked ? "* " : " ");
+		if (nodes[node].right != start) {
+			open.push_back(nodes[node].right);
+			first.push_back(start);
+		}
+		if (nodes[node].child != NO_NODE) {
+			cout << "( ";
+			open.push_back(NO_NODE);
+			first.push_back(NO_NODE);
+			open.push_back(nodes[node].child);
+			first.push_back(nodes[node].child);
+		}
+	}
+	cout << endl;
+	cout << "------------------ END DEBUG INFO ------------------" << endl;
+}
+
+
+/* ================================= IndexedPQueue ================================= */
+/* Constructor */
+template<typename ElemType>
+IndexedPQueue<ElemType>::IndexedPQueue(int (*cmp)(ElemType, ElemType) = OperatorCmp){
+	comparator = cmp;
+}
+
+/* Destructor */
+template<typename ElemType>
+IndexedPQueue<ElemType>::~IndexedPQueue(){
+}
+
+/* Checks if the queue is empty or not*/
+template<typename ElemType>
+bool IndexedPQueue<ElemType>::isEmpty(){
+	return heap.isEmpty();
+}
+
+/* Returns the size of queue*/
+template<typename ElemType>
+int IndexedPQueue<ElemType>::size(){
+	return (int)heap.size();
+}
+
+/* Returns true if value at node1 is greater than value at node2. False otherwise. Assumes both node exist */
+template<typename ElemType>
+bool IndexedPQueue<ElemType>::compareNode(int node1, int node2){
+	return comparator(elements[heap[node1]], elements[heap[node2]]) > 0;
+}
+
+/* Swaps the handles at each node and keeps the position map in step */
+template<typename ElemType>
+void IndexedPQueue<ElemType>::swap(int node1, int node2){
+	int temp = heap[node1];
+	heap[node1] = heap[node2];
+	heap[node2] = temp;
+	position[heap[node1]] = node1;
+	position[heap[node2]] = node2;
+}
+
+/*
+ * Member function: bubbleUp
+ * -------------------------
+ * Same as PQueue::bubbleUp: swaps the handle with its parent till it is either less than or equal to its parent.
+ */
+template<typename ElemType>
+void IndexedPQueue<ElemType>::bubbleUp(int focusNode){
+	if(focusNode == 0) return;                       // Base case
+	int parentNode = (focusNode - 1)/2;
+	if(!compareNode(focusNode, parentNode)) return;  // Base case
+
+	swap(focusNode, parentNode);
+	bubbleUp(parentNode);	                         // else
+}
+
+/*
+ * Member function: heapify
+ * ------------------------
+ * Same as PQueue::heapify: swaps the handle with its larger child till it is larger than both children or at the
+ * last node.
+ */
+template<typename ElemType>
+void IndexedPQueue<ElemType>::heapify(int parentNode){
+	int largest = parentNode;
+	int child1 = 2*parentNode + 1;     // left child
+	int child2 = 2*(parentNode + 1);   // right child
+	if(child1 < size() && compareNode(child1, largest))
+		largest = child1;
+	if(child2 < size() && compareNode(child2, largest))
+		largest = child2;
+	if(largest == parentNode) return;  // Base case
+	swap(parentNode, largest);
+	heapify(largest);
+}
+
+/* Removes the handle at the last heap node and recycles it */
+template<typename ElemType>
+void IndexedPQueue<ElemType>::removeLast(){
+	int handle = heap[size() - 1];
+	heap.removeAt(size() - 1);
+	position[handle] = -1;
+	freeHandles.add(handle);
+}
+
+/* Reports an error if the handle is not in the queue */
+template<typename ElemType>
+void IndexedPQueue<ElemType>::checkHandle(int handle, string operation){
+	if(!contains(handle))
+		Error(operation + ": handle is not in the queue");
+}
+
+/* Enqueues the new element and returns its handle */
+template<typename ElemType>
+int IndexedPQueue<ElemType>::enqueue(ElemType newElement){
+	int handle;
+	if(freeHandles.isEmpty()){
+		handle = elements.size();
+		elements.add(newElement);
+		position.add(size());
+	}
+	else{
+		handle = freeHandles[freeHandles.size() - 1];
+		freeHandles.removeAt(freeHandles.size() - 1);
+		elements[handle] = newElement;
+		position[handle] = size();
+	}
+	heap.add(handle);
+	bubbleUp(size() - 1);   // Moves the new element at appropriate position in the heap.
+	return handle;
+}
+
+/* Dequeues the element with highest priority */
+template<typename ElemType>
+ElemType IndexedPQueue<ElemType>::dequeueMax(){
+	if(size() == 0)
+		Error("Empty heap!");
+	swap(0, size() - 1);
+	ElemType maxElem = elements[heap[size() - 1]];
+	removeLast();
+	if(size() != 0)
+		heapify(0);    // start heapifying from root node only if more elements exist
+	return maxElem;
+}
+
+/* Returns the element with highest priority without dequeuing it */
+template<typename ElemType>
+ElemType IndexedPQueue<ElemType>::peekMax(){
+	if(size() == 0)
+		Error("Empty heap!");
+	return elements[heap[0]];
+}
+
+/* Returns true if the handle refers to an element currently in the queue */
+template<typename ElemType>
+bool IndexedPQueue<ElemType>::contains(int handle){
+	return handle >= 0 && handle < position.size() && position[handle] != -1;
+}
+
+/* Returns the element stored under the handle */
+template<typename ElemType>
+ElemType IndexedPQueue<ElemType>::getElement(int handle){
+	checkHandle(handle, "getElement");
+	return elements[handle];
+}
+
+/* Gives the element a higher priority and moves it up */
+template<typename ElemType>
+void IndexedPQueue<ElemType>::increaseKey(int handle, ElemType newElement){
+	checkHandle(handle, "increaseKey");
+	if(comparator(newElement, elements[handle]) < 0)
+		Error("increaseKey: new element has a lower priority");
+	elements[handle] = newElement;
+	bubbleUp(position[handle]);
+}
+
+/* Gives the element a lower priority and moves it down */
+template<typename ElemType>
+void IndexedPQueue<ElemType>::decreaseKey(int handle, ElemType newElement){
+	checkHandle(handle, "decreaseKey");
+	if(comparator(newElement, elements[handle]) > 0)
+		Error("decreaseKey: new element has a higher priority");
+	elements[handle] = newElement;
+	heapify(position[handle]);
+}
+
+/* Removes the element stored under the handle. The last element takes its place and is moved up or down. */
+template<typename ElemType>
+void IndexedPQueue<ElemType>::remove(int handle){
+	checkHandle(handle, "remove");
+	int node = position[handle];
+	swap(node, size() - 1);
+	removeLast();
+	if(node < size()){
+		bubbleUp(node);   // at most one of these two moves the element
+		heapify(node);
+	}
+}
+
+/* Returns the memory used by current queue */
+template<typename ElemType>
+int IndexedPQueue<ElemType>::bytesUsed(){
+	return sizeof(*this) + heap.bytesUsed() + elements.bytesUsed() + position.bytesUsed() + freeHandles.bytesUsed();
+}
+
+/* Returns the implementation name */
+template<typename ElemType>
+string IndexedPQueue<ElemType>::implementationName(){
+	return "Indexed heap";
+}
+
+/* Prints the heap contents, handle:element, in heap order */
+template<typename ElemType>
+void IndexedPQueue<ElemType>::printDebuggingInfo()
+{
+	cout << "------------------ START DEBUG INFO ------------------" << endl;
+	cout << "Pqueue contains " << size() << " entries" << endl;
+	for (int i = 0; i < size(); i++) 
+		cout << heap[i] << ":" << elements[heap[i]] << " ";
+	cout << endl;
+	cout << "------------------ END DEBUG INFO ------------------" << endl;
+}
+
+/* ============================ RadixHeap ============================== */
+/*
+ * Function: HighestSetBit
+ * -----------------------
+ * Returns the position (1 .. 32) of the highest set bit of value, or 0 if value is 0.
+ */
+inline int HighestSetBit(unsigned int value){
+#if defined(_MSC_VER)
+	unsigned long index;
+	return _BitScanReverse(&index, value) ? (int)index + 1 : 0;
+#elif defined(__GNUC__)
+	return (value == 0) ? 0 : 32 - __builtin_clz(value);
+#else
+	int position = 0;
+	while(value != 0){
+		value >>= 1;
+		position++;
+	}
+	return position;
+#endif
+}
+
+/* Constructor */
+template<typename ElemType>
+RadixHeap<ElemType>::RadixHeap(){
+	last = 0;
+	count = 0;
+}
+
+/* Destructor */
+template<typename ElemType>
+RadixHeap<ElemType>::~RadixHeap(){
+}
+
+/* Checks if the queue is empty */
+template<typename ElemType>
+bool RadixHeap<ElemType>::isEmpty(){
+	return count == 0;
+}
+
+/* Returns the number of elements */
+template<typename ElemType>
+int RadixHeap<ElemType>::size(){
+	return count;
+}
+
+/* Adds the element to the bucket of its key */
+template<typename ElemType>
+void RadixHeap<ElemType>::enqueue(ElemType newElement, int key){
+	if(key < 0 || (unsigned int)key < last)
+		Error("RadixHeap: key is smaller than the last key dequeued");
+	entryT entry;
+	entry.key = key;
+	entry.element = newElement;
+	buckets[HighestSetBit(entry.key ^ last)].add(entry);
+	count++;
+}
+
+/* Makes the smallest key of the lowest non-empty bucket the last key and spreads that bucket over the lower ones */
+template<typename ElemType>
+void RadixHeap<ElemType>::refill(){
+	if(!buckets[0].isEmpty()) return;
+	int bucket = 1;
+	while(buckets[bucket].isEmpty())
+		bucket++;
+	Vector<entryT> &entries = buckets[bucket];
+	unsigned int smallest = entries[0].key;
+	for(int i = 1; i < entries.size(); i++)
+		if(entries[i].key < smallest) smallest = entries[i].key;
+	last = smallest;
+	for(int i = 0; i < entries.size(); i++)
+		buckets[HighestSetBit(entries[i].key ^ last)].add(entries[i]);   // always a lower bucket
+	entries.clear();
+}
+
+/* Dequeues an element of bucket 0, after refilling it if needed */
+template<typename ElemType>
+ElemType RadixHeap<ElemType>::dequeueMin(){
+	if(count == 0)
+		Error("Empty heap!");
+	refill();
+	Vector<entryT> &lowest = buckets[0];
+	ElemType minElem = lowest[lowest.size() - 1].element;
+	lowest.removeAt(lowest.size() - 1);
+	count--;
+	return minElem;
+}
+
+/* Returns the key of bucket 0, after refilling it if needed */
+template<typename ElemType>
+int RadixHeap<ElemType>::peekMinKey(){
+	if(count == 0)
+		Error("Empty heap!");
+	refill();
+	return last;
+}
+
+/* Returns the last key dequeued */
+template<typename ElemType>
+int RadixHeap<ElemType>::lastKey(){
+	return last;
+}
+
+/* Returns the memory used by current queue */
+template<typename ElemType>
+int RadixHeap<ElemType>::bytesUsed(){
+	int total = sizeof(*this);
+	for(int i = 0; i < BUCKET_COUNT; i++)
+		total += buckets[i].bytesUsed() - sizeof(buckets[i]);
+	return total;
+}
+
+/* Returns the implementation name */
+template<typename ElemType>
+string RadixHeap<ElemType>::implementationName(){
+	return "Radix heap";
+}
+
+/* Prints the non-empty buckets, key:element */
+template<typename ElemType>
+void RadixHeap<ElemType>::printDebuggingInfo()
+{
+	cout << "------------------ START DEBUG INFO ------------------" << endl;
+	cout << "Pqueue contains " << size() << " entries, last key " << last << endl;
+	for (int i = 0; i < BUCKET_COUNT; i++) {
+		if (buckets[i].isEmpty()) continue;
+		cout << "Bucket " << i << ": ";
+		for (int j = 0; j < buckets[i].size(); j++)
+			cout << buckets[i][j].key << ":" << buckets[i][j].element << " ";
+		cout << endl;
+	}
+	cout << "------------------ END DEBUG INFO ------------------" << endl;
+}
@@ -8,32 +8,101 @@
 #define _pqueue_h
 
 
+#include <vector>
+#include <utility>
 #include "genlib.h"
 #include "disallowcopy.h"
 #include "vector.h"
 #include "cmpfn.h"
 
+/*
+ * Class: FunctionCmp
+ * ------------------
+ * Adapts a comparison callback of the form int cmp(ElemType, ElemType) to the functor form PQueue takes, so that
+ * PQueue<arcT *> pq(CmpByDistance) keeps working unchanged. The callback is still called through a pointer and
+ * still receives copies of the elements; a functor type of its own avoids both.
+ */
+template <typename ElemType>
+class FunctionCmp{
+	public:
+		FunctionCmp(int (*comparator)(ElemType, ElemType) = OperatorCmp) : comparator(comparator) {}
+
+		int operator()(const ElemType &one, const ElemType &two) const{
+			return comparator(one, two);
+		}
+
+	private:
+		int (*comparator)(ElemType, ElemType);
+};
+
 /* 
  * Class: PQueue
  * --------------
  * This is the class for a priority queue based on a chunklist.
  * This is not a FIFO queue, instead the dequeing process is done based upon the priority of the element.
  * The priority is saved as san integer. (Larger integer is higher priority)
+ *
+ * The comparison is a template parameter: any functor or lambda that can be called as cmp(one, two) on two const
+ * references and returns a value greater than 0 if one has the higher priority (true counts as 1). The compiler can
+ * inline such a comparison, and elements are never copied to compare them. The default, FunctionCmp, takes the
+ * classic callback instead:
+ *     PQueue<arcT *> pq(CmpByDistance);
+ *     auto shorter = [](const pathT &a, const pathT &b){ return a.distance < b.distance; };
+ *     PQueue<pathT, decltype(shorter)> paths(shorter);
+ * Elements are moved rather than copied inside the queue, so move-only types such as unique_ptr work too.
  */
-template <typename ElemType>
+template <typename ElemType, typename CompareType = FunctionCmp<ElemType> >
 class PQueue{
 	public:
 		/* Constructor and destructor */
-		PQueue(int (*comparator)(ElemType, ElemType) = OperatorCmp);
+		PQueue(CompareType comparator = CompareType());
 		~PQueue();
 
+		/*
+		 * Constructor: PQueue
+		 * Usage: PQueue<arcT *> pq(arcs, CmpByDistance);
+		 *        PQueue<int> pq(array, array + count);
+		 * ----------------------------------------------
+		 * Builds the queue from all elements of a Vector or an iterator range at once, as enqueueAll does.
+		 */
+		PQueue(Vector<ElemType> &elements, CompareType comparator = CompareType(), int numThreads = 1);
+		template <typename IteratorType>
+		PQueue(IteratorType first, IteratorType last, CompareType comparator = CompareType(), int numThreads = 1);
+
 		/* Checks if the queue is empty or not*/
 		bool isEmpty();
 
-		/* Enqueues the new element to the priority queue*/
-		void enqueue(ElemType newElement);
+		/* Enqueues a copy of the new element to the priority queue*/
+		void enqueue(const ElemType &newElement);
 
-		/* Dequeues the element with highest priority */
+		/* Enqueues the new element to the priority queue, moving it in */
+		void enqueue(ElemType &&newElement);
+
+		/*
+		 * Member function: emplace
+		 * Usage: pq.emplace(distance, arc);
+		 * ---------------------------------
+		 * Enqueues a new element constructed in place from the arguments.
+		 */
+		template <typename... ArgTypes>
+		void emplace(ArgTypes&&... args);
+
+		/*
+		 * Member function: enqueueAll
+		 * Usage: pq.enqueueAll(elements);
+		 *        pq.enqueueAll(first, last, numThreads);
+		 * ----------------------------------------------
+		 * Enqueues copies of all elements of a Vector or an iterator range. They are appended first and the heap is
+		 * rebuilt bottom-up (Floyd's construction), which costs O(n) comparisons for n elements in all instead of
+		 * O(n log n) for n enqueues. Appending a few elements to a much larger queue bubbles each one up instead,
+		 * whichever is cheaper. With numThreads above 1 and a queue of at least PARALLEL_HEAPIFY_MIN elements, the
+		 * lower subtrees are rebuilt on separate threads, so the comparison must be safe to call concurrently.
+		 */
+		void enqueueAll(Vector<ElemType> &elements, int numThreads = 1);
+		template <typename IteratorType>
+		void enqueueAll(IteratorType first, IteratorType last, int numThreads = 1);
+
+		/* Dequeues the element with highest priority, moving it out */
 		ElemType dequeueMax();
 
 		/* Returns the size of queue*/
@@ -82,49 +151,557 @@ class PQueue{
 		 * calculated by (childIndex - 1)/2 and ignoring the remainder. Conversely, the two child(left and right) of 
 		 * each parent would respectively be at index: 2*parentIndex + 1 and 2*(parentIndex + 1)
 		 */
-		 Vector<ElemType> heap;  
+		 std::vector<ElemType> heap;  
 		
 		/* ===================== Enqueue helpers =====================*/
 		/*
 		 * Member function: bubbleUp
 		 * -------------------------
 		 * Helper to enqueue funtion to help the bubble up operation. This operation moves the newElement add at the
-		 * last of heap to the appropriate position in heap. The behaviour is achieved by swapping the element with its parent
-		 * till it is either less than or equal to its parent.
+		 * last of heap to the appropriate position in heap. Parents of lower priority move down one level each,
+		 * into the hole the element leaves, till the element is less than or equal to its parent.
 		 */
 		void bubbleUp(int focusNode);
 		/* Returns true if the passed node is root node of heap */
-		bool PQueue::isRoot(int node);
+		bool isRoot(int node);
 		/* Returns the index of parent node of the node passed as argument */
-		int PQueue::getParent(int node);
-		/* Returns true if value at node1 is greater than value at node2. False otherwise. Assumes both node exist */
-		bool PQueue::compareNode(int node1, int node2);
-		/* Swaps the value at each node */
-		void PQueue::swap(int node1, int node2);
+		int getParent(int node);
+		/* Returns true if element one has a higher priority than element two */
+		bool higher(const ElemType &one, const ElemType &two);
 
         /* ============== Dequeue helpers ==================*/
-		/* Function: isLast
-		 * ----------------
-		 * Returns true if the argument node is last in the heap
-		 */
-		bool isLast(int node);
 		/* Function: heapify
 		 * -----------------
 		 * This function rearrange the heap in its proper heap form. Concretely, it rearrange the root node to its 
-		 * apt position by comparing each parent with its child node and swapping till the parent is either the largest
+		 * apt position by moving its larger child up into its place till the parent is either the largest
 		 * or at the last node.
 		 */
 		void heapify(int parentNode);
-		/* Function: getChildren
-		 * ---------------------
-		 * This function saves the index of children of parent node in the children vector (passed by reference for efficiency reasons)
+
+		/* ============== Bulk build helpers ==================*/
+		/* Smallest queue rebuilt on several threads; below it starting the threads costs more than they save */
+		static const int PARALLEL_HEAPIFY_MIN = 1 << 18;
+
+		/*
+		 * Member function: restoreHeap
+		 * ----------------------------
+		 * Restores the heap order after elements were appended from index firstAdded on, by bubbling each of them
+		 * up or by rebuilding the whole heap, whichever takes fewer comparisons.
+		 */
+		void restoreHeap(int firstAdded, int numThreads);
+		/* Floyd's construction: heapifies every parent node, the last one first */
+		void buildHeap(int numThreads);
+		/* Heapifies the parent nodes of the subtree under root, its lowest level first */
+		void heapifySubtree(int root);
+
+		/* Comparison passed by client*/
+		CompareType comparator;
+};
+
+/*
+ * Class: MaxFirst, MinFirst
+ * -------------------------
+ * Comparison functors for keys with the < operator: MaxFirst gives the larger key the higher priority, as
+ * OperatorCmp does, and MinFirst the smaller one. With either one on int keys, DaryHeap picks the best child of a
+ * node group with SIMD compares.
+ */
+template <typename ElemType>
+struct MaxFirst{
+	int operator()(const ElemType &one, const ElemType &two) const{
+		return (two < one) ? 1 : ((one < two) ? -1 : 0);
+	}
+};
+
+template <typename ElemType>
+struct MinFirst{
+	int operator()(const ElemType &one, const ElemType &two) const{
+		return (one < two) ? 1 : ((two < one) ? -1 : 0);
+	}
+};
+
+/* Size of a cache line in bytes, the unit DaryHeap aligns its node groups to */
+const int CACHE_LINE_BYTES = 64;
+
+/*
+ * Class: HeapGroupAllocator
+ * -------------------------
+ * The allocator of the DaryHeap storage. It takes memory aligned to a cache line and hands it out one element
+ * before the line boundary, so that element 1, the first child of the root, starts a cache line. The children of
+ * node k are the elements d*k + 1 .. d*k + d, so every group of siblings then starts d*k elements after a line
+ * boundary: with d elements of a size that divides 64 bytes (four or eight ints, say), no group ever straddles two
+ * cache lines, and a larger group starts at a line boundary.
+ */
+template <typename ElemType>
+class HeapGroupAllocator{
+	public:
+		typedef ElemType value_type;
+
+		HeapGroupAllocator(){}
+		template <typename OtherType>
+		HeapGroupAllocator(const HeapGroupAllocator<OtherType> &){}
+
+		ElemType *allocate(size_t count);
+		void deallocate(ElemType *elements, size_t count);
+
+		/* Bytes taken from the system for count elements, for bytesUsed */
+		static size_t allocationBytes(size_t count);
+
+		template <typename OtherType>
+		bool operator==(const HeapGroupAllocator<OtherType> &) const { return true; }
+		template <typename OtherType>
+		bool operator!=(const HeapGroupAllocator<OtherType> &) const { return false; }
+
+	private:
+		/* Distance from the start of the aligned block to the first element */
+		static size_t shift();
+};
+
+/*
+ * Arity of DaryHeap when none is given, fixed at compile time: 4 or 8. Four children of an int fill 16 bytes and
+ * eight fill 32, one SSE or AVX2 register each.
+ */
+#ifndef DARY_HEAP_ARITY
+#define DARY_HEAP_ARITY 4
+#endif
+
+/*
+ * Class: DaryHeap
+ * ---------------
+ * A heap based priority queue like PQueue, with the same interface and comparison convention, in which every node
+ * has Arity children instead of two. The heap is half as deep with four children and a third as deep with eight,
+ * so a dequeue touches fewer levels, and the siblings it compares at each level lie in one cache line (see
+ * HeapGroupAllocator): a million-element queue that does not fit in the caches takes about half the cache misses
+ * per dequeueMax. Enqueues only compare with the parent, so they get cheaper too. In exchange every level of a
+ * dequeue compares Arity children.
+ *
+ * For int elements ordered by MaxFirst or MinFirst the best child of a full group is found with SIMD compares:
+ * AVX2 where the compiler targets it, else SSE2, else (or with PQUEUE_NO_SIMD defined) the scalar loop used for
+ * every other element type and comparison. All of them take the first of equal children, so the order in which
+ * equal elements come out does not depend on the instruction set.
+ *     DaryHeap<int, MaxFirst<int> > pq;         // four children, SIMD child selection
+ *     DaryHeap<arcT *> arcs(CmpByDistance);     // four children, scalar
+ *     DaryHeap<int, MinFirst<int>, 8> wide;     // eight children
+ */
+template <typename ElemType, typename CompareType = FunctionCmp<ElemType>, int Arity = DARY_HEAP_ARITY>
+class DaryHeap{
+	public:
+		/* Constructor and destructor */
+		DaryHeap(CompareType comparator = CompareType());
+		~DaryHeap();
+
+		/* Checks if the queue is empty or not*/
+		bool isEmpty();
+
+		/* Enqueues a copy of the new element to the priority queue*/
+		void enqueue(const ElemType &newElement);
+
+		/* Enqueues the new element to the priority queue, moving it in */
+		void enqueue(ElemType &&newElement);
+
+		/* Enqueues a new element constructed in place from the arguments */
+		template <typename... ArgTypes>
+		void emplace(ArgTypes&&... args);
+
+		/* Dequeues the element with highest priority, moving it out */
+		ElemType dequeueMax();
+
+		/* Returns the size of queue*/
+		int size();
+
+		/* Returns the memory used by current queue. Only for performance evaluation purposes*/
+		int bytesUsed();
+
+		/* Returns a string that describes the implementation strategy, with the arity and the child selection */
+		string implementationName();
+
+		/* Prints the heap contents for debugging */
+		void printDebuggingInfo();
+
+	private:
+		DISALLOW_COPYING(DaryHeap)
+
+		static_assert(Arity == 4 || Arity == 8, "DaryHeap: the arity must be 4 or 8");
+
+		/* The elements in level order, the children of node k at Arity*k + 1 .. Arity*k + Arity */
+		std::vector<ElemType, HeapGroupAllocator<ElemType> > heap;
+
+		/* Moves the element at focusNode up till its parent has at least its priority */
+		void bubbleUp(int focusNode);
+		/* Moves the element at parentNode down till none of its children has a higher priority */
+		void heapify(int parentNode);
+		/* Returns the index of the child of highest priority among the count children from firstChild on */
+		int bestChild(int firstChild, int count);
+		/* Returns true if element one has a higher priority than element two */
+		bool higher(const ElemType &one, const ElemType &two);
+
+		/* Comparison passed by client*/
+		CompareType comparator;
+};
+
+/* Index of no node, in the links of the node based heaps */
+const int NO_NODE = -1;
+
+/*
+ * Class: NodePool
+ * ---------------
+ * The node storage of PairingHeap and FibonacciHeap. Nodes live in one growing array and refer to each other by
+ * index, so an enqueue allocates nothing once the pool has grown to the largest size the queue reaches: released
+ * nodes go on a free list and are handed out again first. The index of a node doubles as the handle of its element.
+ */
+template <typename NodeType>
+class NodePool{
+	public:
+		/* Returns the index of an unused node */
+		int allocate();
+
+		/* Gives the node back to the pool */
+		void release(int index);
+
+		/* Returns true if index is a node handed out and not released */
+		bool isUsed(int index);
+
+		/* Returns the node at index */
+		NodeType &operator[](int index){
+			return nodes[index];
+		}
+
+		/* Returns the memory used by the nodes and the free list */
+		int bytesUsed();
+
+	private:
+		std::vector<NodeType> nodes;
+		std::vector<bool> used;
+		std::vector<int> freeNodes;   // released nodes, reused last released first
+};
+
+/*
+ * Class: PairingHeap
+ * ------------------
+ * A priority queue with the interface and comparison convention of IndexedPQueue, as a pairing heap: a tree in which
+ * every node has at least the priority of its children, stored as first child and next sibling links. An enqueue
+ * makes the new node a child of the root or the root a child of the new node, and increaseKey cuts the node's subtree
+ * out and does the same with it, both in O(1). dequeueMax removes the root and melds its children in pairs left to
+ * right, then the pairs right to left, in O(log n) amortized. There is no remove and no decreaseKey.
+ *     PairingHeap<queueEntryT> pq(CmpByQueueKey);
+ *     int handle = pq.enqueue(entry);
+ *     pq.increaseKey(handle, shorterEntry);
+ */
+template <typename ElemType, typename CompareType = FunctionCmp<ElemType> >
+class PairingHeap{
+	public:
+		/* Constructor and destructor */
+		PairingHeap(CompareType comparator = CompareType());
+		~PairingHeap();
+
+		/* Checks if the queue is empty or not*/
+		bool isEmpty();
+
+		/* Returns the size of queue*/
+		int size();
+
+		/* Enqueues the new element and returns its handle */
+		int enqueue(ElemType newElement);
+
+		/* Dequeues the element with highest priority */
+		ElemType dequeueMax();
+
+		/* Returns the element with highest priority without dequeuing it */
+		ElemType peekMax();
+
+		/* Returns true if the handle refers to an element currently in the queue */
+		bool contains(int handle);
+
+		/* Returns the element stored under the handle */
+		ElemType getElement(int handle);
+
+		/* Replaces the element under the handle by newElement, which must have the same or a higher priority */
+		void increaseKey(int handle, ElemType newElement);
+
+		/* Returns the memory used by current queue. Only for performance evaluation purposes*/
+		int bytesUsed();
+
+		/* Returns a string that describes the implementation strategy */
+		string implementationName();
+
+		/* Prints the trees for debugging */
+		void printDebuggingInfo();
+
+	private:
+		DISALLOW_COPYING(PairingHeap)
+
+		struct nodeT{
+			ElemType element;
+			int child;     // first child
+			int sibling;   // next sibling
+			int prev;      // previous sibling, or the parent of a first child
+		};
+		NodePool<nodeT> nodes;
+		int root;
+		int count;
+		std::vector<int> pairs;   // scratch list of the melded pairs of dequeueMax
+
+		/* Makes the root of lower priority the first child of the other and returns the new root */
+		int meld(int one, int two);
+		/* Unlinks the subtree under node from its parent and siblings */
+		void cut(int node);
+		/* Reports an error if the handle is not in the queue */
+		void checkHandle(int handle, string operation);
+		/* Returns true if element one has a higher priority than element two */
+		bool higher(const ElemType &one, const ElemType &two);
+
+		/* Comparison passed by client*/
+		CompareType comparator;
+};
+
+/*
+ * Class: FibonacciHeap
+ * --------------------
+ * A priority queue with the interface and comparison convention of IndexedPQueue, as a Fibonacci heap: a circular
+ * list of trees, each of which has every node at least at the priority of its children. An enqueue adds a tree of
+ * one node to the list, and increaseKey cuts the node out to the list if it now beats its parent; a parent that
+ * loses a second child is cut out as well (cascading cut), which keeps a tree of degree d at Fibonacci(d + 2) nodes
+ * or more. Both are O(1) amortized. dequeueMax moves the children of the root to the list and links trees of equal
+ * degree till all degrees differ, in O(log n) amortized. There is no remove and no decreaseKey.
+ */
+template <typename ElemType, typename CompareType = FunctionCmp<ElemType> >
+class FibonacciHeap{
+	public:
+		/* Constructor and destructor */
+		FibonacciHeap(CompareType comparator = CompareType());
+		~FibonacciHeap();
+
+		/* Checks if the queue is empty or not*/
+		bool isEmpty();
+
+		/* Returns the size of queue*/
+		int size();
+
+		/* Enqueues the new element and returns its handle */
+		int enqueue(ElemType newElement);
+
+		/* Dequeues the element with highest priority */
+		ElemType dequeueMax();
+
+		/* Returns the element with highest priority without dequeuing it */
+		ElemType peekMax();
+
+		/* Returns true if the handle refers to an element currently in the queue */
+		bool contains(int handle);
+
+		/* Returns the element stored under the handle */
+		ElemType getElement(int handle);
+
+		/* Replaces the element under the handle by newElement, which must have the same or a higher priority */
+		void increaseKey(int handle, ElemType newElement);
+
+		/* Returns the memory used by current queue. Only for performance evaluation purposes*/
+		int bytesUsed();
+
+		/* Returns a string that describes the implementation strategy */
+		string implementationName();
+
+		/* Prints the trees for debugging */
+		void printDebuggingInfo();
+
+	private:
+		DISALLOW_COPYING(FibonacciHeap)
+
+		struct nodeT{
+			ElemType element;
+			int parent;
+			int child;     // any one child
+			int left;      // neighbours in the circular list of siblings (or of trees)
+			int right;
+			int degree;    // number of children
+			bool marked;   // lost a child since it became a child itself
+		};
+		NodePool<nodeT> nodes;
+		int top;                     // root of highest priority, NO_NODE if empty
+		int count;
+		std::vector<int> trees;      // scratch list of the trees of dequeueMax
+		std::vector<int> byDegree;   // scratch table of dequeueMax: degree -> the tree of that degree
+
+		/* Inserts node into the circular list to the right of anchor */
+		void splice(int node, int anchor);
+		/* Removes node from its circular list */
+		void unlink(int node);
+		/* Makes the tree under child a child of parent */
+		void link(int child, int parent);
+		/* Moves the tree under node from its parent to the list of trees */
+		void cut(int node);
+		/* Links trees of equal degree till all degrees differ, and finds the new top */
+		void consolidate();
+		/* Reports an error if the handle is not in the queue */
+		void checkHandle(int handle, string operation);
+		/* Returns true if element one has a higher priority than element two */
+		bool higher(const ElemType &one, const ElemType &two);
+
+		/* Comparison passed by client*/
+		CompareType comparator;
+};
+
+/*
+ * Class: IndexedPQueue
+ * --------------------
+ * This is an addressable variant of the heap based priority queue. Every enqueue returns a handle that stays valid
+ * for as long as the element is in the queue, and through that handle the element can later be looked up, given a
+ * higher or lower priority or removed without searching the heap. A position map from handle to heap index is kept
+ * up to date by every swap. Handles of dequeued or removed elements are recycled by later enqueues.
+ * Uses the same comparator convention as PQueue: the element the comparator ranks larger is dequeued first.
+ */
+template <typename ElemType>
+class IndexedPQueue{
+	public:
+		/* Constructor and destructor */
+		IndexedPQueue(int (*comparator)(ElemType, ElemType) = OperatorCmp);
+		~IndexedPQueue();
+
+		/* Checks if the queue is empty or not*/
+		bool isEmpty();
+
+		/* Returns the size of queue*/
+		int size();
+
+		/* Enqueues the new element and returns its handle */
+		int enqueue(ElemType newElement);
+
+		/* Dequeues the element with highest priority */
+		ElemType dequeueMax();
+
+		/* Returns the element with highest priority without dequeuing it */
+		ElemType peekMax();
+
+		/* Returns true if the handle refers to an element currently in the queue */
+		bool contains(int handle);
+
+		/* Returns the element stored under the handle */
+		ElemType getElement(int handle);
+
+		/*
+		 * Member function: increaseKey
+		 * Usage: pq.increaseKey(handle, newElement);
+		 * ------------------------------------------
+		 * Replaces the element stored under the handle by newElement, which must have the same or a higher priority,
+		 * and moves it up towards the root. In a queue that ranks shorter distances higher, this is the operation
+		 * used when a shorter distance to a node is found.
 		 */
-		void PQueue::getChild(int parentNode, Vector<int> &children);
+		void increaseKey(int handle, ElemType newElement);
+
+		/*
+		 * Member function: decreaseKey
+		 * Usage: pq.decreaseKey(handle, newElement);
+		 * ------------------------------------------
+		 * Replaces the element stored under the handle by newElement, which must have the same or a lower priority,
+		 * and moves it down towards the leaves.
+		 */
+		void decreaseKey(int handle, ElemType newElement);
+
+		/* Removes the element stored under the handle from the queue */
+		void remove(int handle);
+
+		/* Returns the memory used by current queue. Only for performance evaluation purposes*/
+		int bytesUsed();
+
+		/* Returns a string that describes the implementation strategy */
+		string implementationName();
+
+		/* Prints the heap contents for debugging */
+		void printDebuggingInfo();
+
+	private:
+		DISALLOW_COPYING(IndexedPQueue)
+
+		/* The heap stores handles, laid out exactly like PQueue::heap. The element of a handle is in elements and
+		 * the heap index of a handle is in position (-1 once the handle is no longer in the queue). */
+		Vector<int> heap;
+		Vector<ElemType> elements;
+		Vector<int> position;
+		Vector<int> freeHandles;  // handles that can be reused by enqueue
+
+		/* Moves the handle at focusNode up till its parent has at least its priority */
+		void bubbleUp(int focusNode);
+		/* Moves the handle at parentNode down till both its children have at most its priority */
+		void heapify(int parentNode);
+		/* Returns true if value at node1 is greater than value at node2 */
+		bool compareNode(int node1, int node2);
+		/* Swaps the handles at each node and updates their positions */
+		void swap(int node1, int node2);
+		/* Removes the handle at the last heap node and recycles it */
+		void removeLast();
+		/* Reports an error if the handle is not in the queue */
+		void checkHandle(int handle, string operation);
 
 		/* Pointer to callback function passed by client*/
 		int (*comparator)(ElemType, ElemType);
 };
 
+/*
+ * Class: RadixHeap
+ * ----------------
+ * This is a monotone priority queue for elements with non-negative integer keys, for use where keys are never
+ * smaller than the last key dequeued (as in Dijkstra's algorithm with non-negative arc distances). Elements are kept
+ * in 33 buckets by the highest bit in which their key differs from the last dequeued key. A dequeue that finds the
+ * lowest bucket empty takes the next non-empty bucket, makes its smallest key the new last key and spreads its
+ * elements over the lower buckets. Each element moves down at most 32 times, so an enqueue and dequeue pair is
+ * O(log C) amortized for keys up to C, and no comparator is ever called. Elements with the smallest key come out first.
+ */
+template <typename ElemType>
+class RadixHeap{
+	public:
+		/* Constructor and destructor */
+		RadixHeap();
+		~RadixHeap();
+
+		/* Checks if the queue is empty or not*/
+		bool isEmpty();
+
+		/* Returns the size of queue*/
+		int size();
+
+		/*
+		 * Member function: enqueue
+		 * Usage: rh.enqueue(element, key);
+		 * --------------------------------
+		 * Adds the element with the given key. Reports an error if the key is smaller than the last key dequeued,
+		 * which would break the monotone order the queue relies on.
+		 */
+		void enqueue(ElemType newElement, int key);
+
+		/* Dequeues an element with the smallest key */
+		ElemType dequeueMin();
+
+		/* Returns the smallest key in the queue without dequeuing anything */
+		int peekMinKey();
+
+		/* Returns the key of the last element dequeued, 0 before the first dequeue */
+		int lastKey();
+
+		/* Returns the memory used by current queue. Only for performance evaluation purposes*/
+		int bytesUsed();
+
+		/* Returns a string that describes the implementation strategy */
+		string implementationName();
+
+		/* Prints the bucket contents for debugging */
+		void printDebuggingInfo();
+
+	private:
+		DISALLOW_COPYING(RadixHeap)
+
+		static const int BUCKET_COUNT = 33;   // bucket 0 holds keys equal to last, bucket b keys differing in bit b-1
+
+		struct entryT{
+			unsigned int key;
+			ElemType element;
+		};
+		Vector<entryT> buckets[BUCKET_COUNT];
+		unsigned int last;   // the last key dequeued; no key in the queue is smaller
+		int count;
+
+		/* Moves the elements of the lowest non-empty bucket down so that bucket 0 holds the smallest key */
+		void refill();
+};
+
 #include "pqheap.cpp"
 
 
@@ -0,0 +1,89 @@
+/*
+ * File: query.cpp
+ * ---------------
+ * This file implements the dispatch of a query to the search engine of the selected mode.
+ */
+
+#include <iostream>
+#include "query.h"
+#include "landmarks.h"
+#include "treecache.h"
+
+string SearchModeName(searchModeT mode){
+	switch(mode){
+		case ASTAR_SEARCH: return "A*";
+		case BIDIRECTIONAL_SEARCH: return "bidirectional Dijkstra";
+		case HIERARCHY_SEARCH: return "contraction hierarchy";
+		case LANDMARK_SEARCH: return "A* with landmarks";
+		case CACHED_TREE_SEARCH: return "Dijkstra with cached trees";
+		default: return "Dijkstra";
+	}
+}
+
+void PrepareSearchMode(graphT &graph, searchModeT mode){
+	if(mode == HIERARCHY_SEARCH)
+		GetContractionHierarchy(graph);
+	else if(mode == LANDMARK_SEARCH)
+		GetLandmarkTable(graph);
+	else if(mode == CACHED_TREE_SEARCH)
+		GetTreeCache(graph);
+}
+
+/* Answers the query with the engine of the mode */
+static bool RunEngine(graphT &graph, searchModeT mode, nodeT *source, nodeT *target, queryScratchT &scratch,
+                      Stack<arcT *> &path, int &distance, int &dequeues){
+	bool found;
+	if(mode == BIDIRECTIONAL_SEARCH){
+		bidirectionalStateT &state = scratch.bidirectional;
+		found = FindShortestPathBidirectional(graph, source, target, state);
+		path = ExtractBidirectionalPath(state, source, target);
+		distance = state.distance;
+		dequeues = state.dequeues;
+		return found;
+	}
+	if(mode == HIERARCHY_SEARCH){
+		contractionHierarchyT *ch = GetContractionHierarchy(graph);  // builds it on first use
+		chQueryStateT &state = scratch.hierarchy;
+		found = FindShortestPathCH(graph, *ch, source, target, state);
+		path = ExtractPathCH(graph, *ch, state, source, target);
+		distance = state.distance;
+		dequeues = state.dequeues;
+		return found;
+	}
+	searchStateT &state = scratch.search;
+	if(mode == CACHED_TREE_SEARCH){
+		bool hit;
+		found = FindShortestPathCached(graph, source, target, state, path, distance, hit);
+		dequeues = hit ? 0 : state.dequeues;
+		return found;
+	}
+	if(mode == ASTAR_SEARCH)
+		found = FindShortestPath(graph, source, target, state, CoordinateHeuristic, &graph);
+	else if(mode == LANDMARK_SEARCH)  // builds the landmark tables on first use
+		found = FindShortestPath(graph, source, target, state, LandmarkHeuristic, GetLandmarkTable(graph));
+	else
+		found = FindShortestPath(graph, source, target, state);
+	path = ExtractPath(state, source, target);
+	distance = state.dist[target->id];
+	dequeues = state.dequeues;
+	return found;
+}
+
+bool RunQuery(graphT &graph, searchModeT mode, nodeT *source, nodeT *target, queryScratchT &scratch,
+              Stack<arcT *> &path, int &distance, int &dequeues, searchStatsT *stats){
+	if(stats == NULL)
+		return RunEngine(graph, mode, source, target, scratch, path, distance, dequeues);
+	BeginSearchStats(*stats);
+	bool found = RunEngine(graph, mode, source, target, scratch, path, distance, dequeues);
+	EndSearchStats(*stats);
+	return found;
+}
+
+void PrintTreeCacheCounters(graphT &graph){
+	treeCacheT *cache = graph.treeCache;
+	if(cache == NULL) return;
+	lock_guard<mutex> guard(cache->lock);
+	cout << "Tree cache: " << cache->hits << " hits, " << cache->misses << " misses, " << cache->evictions
+	     << " evictions, " << cache->usedBytes / 1024 << " of " << cache->budgetBytes / 1024 << " KB used, "
+	     << cache->repairedNodes << " nodes repaired" << endl;
+}
@@ -0,0 +1,78 @@
+/*
+ * File: query.h
+ * -------------
+ * This module puts the shortest path engines behind one call, so the interactive program and the batch mode can
+ * answer a query in any search mode. The scratch state of every engine is kept in a queryScratchT owned by the
+ * caller; each thread answering queries needs its own, while the graph and its preprocessed data are only read.
+ */
+
+#ifndef _query_h
+#define _query_h
+
+#include "genlib.h"
+#include "stack.h"
+#include "pathgraph.h"
+#include "shortestpath.h"
+#include "contraction.h"
+#include "searchstats.h"
+
+/* Algorithms offered for finding the shortest path */
+enum searchModeT{
+	DIJKSTRA_SEARCH,
+	ASTAR_SEARCH,
+	BIDIRECTIONAL_SEARCH,
+	HIERARCHY_SEARCH,
+	LANDMARK_SEARCH,
+	CACHED_TREE_SEARCH
+};
+
+/*
+ * Type: queryScratchT
+ * -------------------
+ * The scratch state of all search engines. It can be reused for any number of queries, in any mode.
+ */
+struct queryScratchT{
+	searchStateT search;
+	bidirectionalStateT bidirectional;
+	chQueryStateT hierarchy;
+};
+
+/*
+ * Function: SearchModeName
+ * Usage: cout << SearchModeName(mode);
+ * ------------------------------------
+ * Returns a short name of the search mode for messages and reports.
+ */
+string SearchModeName(searchModeT mode);
+
+/*
+ * Function: PrepareSearchMode
+ * Usage: PrepareSearchMode(graph, mode);
+ * --------------------------------------
+ * Loads or builds the preprocessed data the mode needs (the hierarchy or the landmark tables). RunQuery does this
+ * on first use, but it must be called beforehand when several threads are going to run queries at once.
+ */
+void PrepareSearchMode(graphT &graph, searchModeT mode);
+
+/*
+ * Function: RunQuery
+ * Usage: if(RunQuery(graph, mode, source, target, scratch, path, distance, dequeues)) ...
+ *        if(RunQuery(graph, mode, source, target, scratch, path, distance, dequeues, &stats)) ...
+ * ------------------------------------------------------------------------------------------
+ * Finds the shortest path from source to target with the engine selected by mode. Returns true if there is one,
+ * in which case path (in the order of ExtractPath), distance and dequeues describe it. If stats is given it
+ * receives the counters and the wall time of the query (see searchstats.h), including any preprocessing the mode
+ * does on first use.
+ */
+bool RunQuery(graphT &graph, searchModeT mode, nodeT *source, nodeT *target, queryScratchT &scratch,
+              Stack<arcT *> &path, int &distance, int &dequeues, searchStatsT *stats = NULL);
+
+/*
+ * Function: PrintTreeCacheCounters
+ * Usage: PrintTreeCacheCounters(graph);
+ * -------------------------------------
+ * Prints the hit, miss, eviction and repair counters of the graph's shortest path tree cache, if it has one.
+ */
+void PrintTreeCacheCounters(graphT &graph);
+
+#endif
@@ -0,0 +1,186 @@
+/*
+ * File: searchstats.cpp
+ * ---------------------
+ * This file implements the query clock, the reports and the export of the search counters.
+ */
+
+#include <fstream>
+#include <chrono>
+#include "searchstats.h"
+
+#if PATHFINDER_STATS
+thread_local searchStatsT *activeSearchStats = NULL;
+#endif
+
+/* Start time of the query being measured on this thread */
+static thread_local chrono::steady_clock::time_point queryStart;
+
+void ResetSearchStats(searchStatsT &stats){
+	stats.settled = stats.relaxed = 0;
+	stats.pushes = stats.pops = stats.decreaseKeys = stats.maxQueueSize = 0;
+	stats.comparisons = 0;
+	stats.microseconds = 0;
+}
+
+void BeginSearchStats(searchStatsT &stats){
+	ResetSearchStats(stats);
+#if PATHFINDER_STATS
+	activeSearchStats = &stats;
+#endif
+	queryStart = chrono::steady_clock::now();
+}
+
+void EndSearchStats(searchStatsT &stats){
+	stats.microseconds = chrono::duration<double, micro>(chrono::steady_clock::now() - queryStart).count();
+#if PATHFINDER_STATS
+	activeSearchStats = NULL;
+#endif
+}
+
+void PrintSearchStats(searchStatsT &stats, ostream &out){
+	out << "Settled " << stats.settled << " nodes, relaxed " << stats.relaxed << " arcs, " << stats.pushes
+	    << " pushes, " << stats.pops << " pops, " << stats.decreaseKeys << " decrease keys, largest queue "
+	    << stats.maxQueueSize << ", " << stats.comparisons << " comparisons, " << stats.microseconds << " us" << endl;
+}
+
+/* Counters summed over all queries, except maxQueueSize, which is the largest */
+static searchStatsT SumSearchStats(Vector<searchStatsT> &allStats){
+	searchStatsT total;
+	ResetSearchStats(total);
+	for(int i = 0; i < allStats.size(); i++){
+		searchStatsT &stats = allStats[i];
+		total.settled += stats.settled;
+		total.relaxed += stats.relaxed;
+		total.pushes += stats.pushes;
+		total.pops += stats.pops;
+		total.decreaseKeys += stats.decreaseKeys;
+		if(stats.maxQueueSize > total.maxQueueSize) total.maxQueueSize = stats.maxQueueSize;
+		total.comparisons += stats.comparisons;
+		total.microseconds += stats.microseconds;
+	}
+	return total;
+}
+
+/* Histogram bucket of a value: 0 for [0, 2), then b for [2^b, 2^(b+1)) */
+static int HistogramBucket(long long value){
+	int bucket = 0;
+	while(value >= 2){
+		value >>= 1;
+		bucket++;
+	}
+	return bucket;
+}
+
+/* Number of queries in each bucket, for the settled nodes or, if byTime, the whole microseconds */
+static Vector<int> MakeHistogram(Vector<searchStatsT> &allStats, bool byTime){
+	Vector<int> counts;
+	for(int i = 0; i < allStats.size(); i++){
+		long long value = byTime ? (long long)allStats[i].microseconds : allStats[i].settled;
+		int bucket = HistogramBucket(value);
+		while(counts.size() <= bucket)
+			counts.add(0);
+		counts[bucket]++;
+	}
+	return counts;
+}
+
+/* Lower end of a histogram bucket */
+static long long BucketStart(int bucket){
+	return (bucket == 0) ? 0 : (1LL << bucket);
+}
+
+/* Writes one histogram with a bar of up to 50 marks per bucket */
+static void PrintHistogram(Vector<int> &counts, string title, ostream &out){
+	out << title << ":" << endl;
+	int largest = 0;
+	for(int i = 0; i < counts.size(); i++)
+		if(counts[i] > largest) largest = counts[i];
+	for(int i = 0; i < counts.size(); i++){
+		if(counts[i] == 0) continue;
+		out << "  [" << BucketStart(i) << ", " << BucketStart(i + 1) << ")\t" << counts[i] << "\t"
+		    << string((counts[i] * 50 + largest - 1) / largest, '#') << endl;
+	}
+}
+
+void PrintSearchStatsReport(Vector<searchStatsT> &allStats, ostream &out){
+	int queries = allStats.size();
+	if(queries == 0) return;
+	searchStatsT total = SumSearchStats(allStats);
+	out << "Search statistics over " << queries << " queries";
+	if(!PATHFINDER_STATS) out << " (counters compiled out, wall time only)";
+	out << endl;
+	out << "  settled nodes: " << total.settled << " total, " << double(total.settled) / queries << " per query" << endl;
+	out << "  relaxed arcs: " << total.relaxed << " total, " << double(total.relaxed) / queries << " per query" << endl;
+	out << "  queue: " << total.pushes << " pushes, " << total.pops << " pops, " << total.decreaseKeys
+	    << " decrease keys, largest " << total.maxQueueSize << endl;
+	out << "  comparisons: " << total.comparisons << " total, " << double(total.comparisons) / queries
+	    << " per query" << endl;
+	out << "  wall time: " << total.microseconds << " us total, " << total.microseconds / queries << " us per query"
+	    << endl;
+	Vector<int> settledCounts = MakeHistogram(allStats, false);
+	PrintHistogram(settledCounts, "Settled nodes per query", out);
+	Vector<int> timeCounts = MakeHistogram(allStats, true);
+	PrintHistogram(timeCounts, "Microseconds per query", out);
+}
+
+bool WriteSearchStatsCSV(Vector<searchStatsT> &allStats, string filename){
+	ofstream out(filename.c_str());
+	if(out.fail()) return false;
+	out << "query,settled,relaxed,pushes,pops,decrease_keys,max_queue_size,comparisons,microseconds" << endl;
+	for(int i = 0; i < allStats.size(); i++){
+		searchStatsT &stats = allStats[i];
+		out << i << "," << stats.settled << "," << stats.relaxed << "," << stats.pushes << "," << stats.pops << ","
+		    << stats.decreaseKeys << "," << stats.maxQueueSize << "," << stats.comparisons << ","
+		    << stats.microseconds << endl;
+	}
+	out.close();
+	return !out.fail();
+}
+
+/* Writes the counters as the members of a JSON object */
+static void WriteJSONCounters(searchStatsT &stats, ostream &out){
+	out << "{\"settled\": " << stats.settled << ", \"relaxed\": " << stats.relaxed << ", \"pushes\": " << stats.pushes
+	    << ", \"pops\": " << stats.pops << ", \"decrease_keys\": " << stats.decreaseKeys << ", \"max_queue_size\": "
+	    << stats.maxQueueSize << ", \"comparisons\": " << stats.comparisons << ", \"microseconds\": "
+	    << stats.microseconds << "}";
+}
+
+/* Writes a histogram as a JSON array of buckets */
+static void WriteJSONHistogram(Vector<int> &counts, ostream &out){
+	out << "[";
+	bool first = true;
+	for(int i = 0; i < counts.size(); i++){
+		if(counts[i] == 0) continue;
+		if(!first) out << ", ";
+		out << "{\"from\": " << BucketStart(i) << ", \"to\": " << BucketStart(i + 1) << ", \"count\": " << counts[i]
+		    << "}";
+		first = false;
+	}
+	out << "]";
+}
+
+bool WriteSearchStatsJSON(Vector<searchStatsT> &allStats, string filename){
+	ofstream out(filename.c_str());
+	if(out.fail()) return false;
+	searchStatsT total = SumSearchStats(allStats);
+	out << "{" << endl;
+	out << "  \"counters_enabled\": " << (PATHFINDER_STATS ? "true" : "false") << "," << endl;
+	out << "  \"total\": ";
+	WriteJSONCounters(total, out);
+	out << "," << endl << "  \"settled_histogram\": ";
+	Vector<int> settledCounts = MakeHistogram(allStats, false);
+	WriteJSONHistogram(settledCounts, out);
+	out << "," << endl << "  \"microseconds_histogram\": ";
+	Vector<int> timeCounts = MakeHistogram(allStats, true);
+	WriteJSONHistogram(timeCounts, out);
+	out << "," << endl << "  \"queries\": [" << endl;
+	for(int i = 0; i < allStats.size(); i++){
+		out << "    ";
+		WriteJSONCounters(allStats[i], out);
+		if(i + 1 < allStats.size()) out << ",";
+		out << endl;
+	}
+	out << "  ]" << endl << "}" << endl;
+	out.close();
+	return !out.fail();
+}
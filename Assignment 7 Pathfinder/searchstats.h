@@ -0,0 +1,105 @@
+/*
+ * File: searchstats.h
+ * -------------------
+ * This module exports the instrumentation of the search engines: per query counters of the work done (nodes
+ * settled, arcs relaxed, priority queue operations, comparison callbacks) and the wall time, plus reports over many
+ * queries with histograms, written to the console or exported as CSV or JSON.
+ *
+ * The engines bump the counters with the STATS_ADD and STATS_MAX macros inside their inner loops. The counters go to
+ * the searchStatsT of the query running on the same thread, set by BeginSearchStats; searches run without one are
+ * not counted. The macros compile to nothing unless PATHFINDER_STATS is 1, which is the default except when NDEBUG
+ * is defined, as it is in the release configuration. The wall time is measured either way.
+ */
+
+#ifndef _searchstats_h
+#define _searchstats_h
+
+#include <iostream>
+#include "genlib.h"
+#include "vector.h"
+
+#ifndef PATHFINDER_STATS
+#ifdef NDEBUG
+#define PATHFINDER_STATS 0
+#else
+#define PATHFINDER_STATS 1
+#endif
+#endif
+
+/*
+ * Type: searchStatsT
+ * ------------------
+ * The counters of one query. With several queues (as in the bidirectional searches) the counts cover all of them
+ * and maxQueueSize is the largest single queue.
+ */
+struct searchStatsT{
+	long long settled;       // nodes whose distance became final
+	long long relaxed;       // arcs examined from settled nodes
+	long long pushes;        // entries added to a priority queue
+	long long pops;          // entries removed, including outdated ones a lazy queue skips
+	long long decreaseKeys;  // queued nodes moved up, or queued again by a lazy queue
+	long long maxQueueSize;  // most entries in one queue at any time
+	long long comparisons;   // calls of a queue comparison callback
+	double microseconds;     // wall time from BeginSearchStats to EndSearchStats
+};
+
+#if PATHFINDER_STATS
+extern thread_local searchStatsT *activeSearchStats;  // counters of the query running on this thread, or NULL
+#define STATS_ADD(field, amount) \
+	do{ if(activeSearchStats != NULL) activeSearchStats->field += (amount); }while(0)
+#define STATS_MAX(field, value) \
+	do{ if(activeSearchStats != NULL && (value) > activeSearchStats->field) activeSearchStats->field = (value); }while(0)
+#else
+#define STATS_ADD(field, amount) ((void)0)
+#define STATS_MAX(field, value) ((void)0)
+#endif
+
+/*
+ * Function: ResetSearchStats
+ * Usage: ResetSearchStats(stats);
+ * -------------------------------
+ * Sets every counter to zero.
+ */
+void ResetSearchStats(searchStatsT &stats);
+
+/*
+ * Function: BeginSearchStats, EndSearchStats
+ * Usage: BeginSearchStats(stats);
+ *        ... searches ...
+ *        EndSearchStats(stats);
+ * -------------------------------
+ * BeginSearchStats resets stats, makes it the target of the counters on the calling thread and starts the clock.
+ * EndSearchStats stops the clock and detaches it. Every search the thread runs in between is counted; the pairs do
+ * not nest.
+ */
+void BeginSearchStats(searchStatsT &stats);
+void EndSearchStats(searchStatsT &stats);
+
+/*
+ * Function: PrintSearchStats
+ * Usage: PrintSearchStats(stats, cout);
+ * -------------------------------------
+ * Writes the counters of one query on one line.
+ */
+void PrintSearchStats(searchStatsT &stats, ostream &out);
+
+/*
+ * Function: PrintSearchStatsReport
+ * Usage: PrintSearchStatsReport(allStats, cout);
+ * ----------------------------------------------
+ * Writes the totals and means of a batch of queries and histograms of the settled nodes and the wall time per
+ * query, with buckets that double in width: [0, 2), [2, 4), [4, 8), ...
+ */
+void PrintSearchStatsReport(Vector<searchStatsT> &allStats, ostream &out);
+
+/*
+ * Function: WriteSearchStatsCSV, WriteSearchStatsJSON
+ * Usage: if(!WriteSearchStatsCSV(allStats, "stats.csv")) ...
+ * ----------------------------------------------------------
+ * Export the counters of every query, one row or object per query in the order given. The JSON file also holds the
+ * totals and the histograms of PrintSearchStatsReport. Return false if the file cannot be written.
+ */
+bool WriteSearchStatsCSV(Vector<searchStatsT> &allStats, string filename);
+bool WriteSearchStatsJSON(Vector<searchStatsT> &allStats, string filename);
+
+#endif
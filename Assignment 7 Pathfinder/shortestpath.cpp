@@ -0,0 +1,373 @@
+/*
+ * File: shortestpath.cpp
+ * ----------------------
+ * This file implements the node indexed shortest path engine. The priority queue holds (node, distance) entries
+ * only, so an enqueue is a constant size copy and a comparison is a single integer compare. Dijkstra's algorithm and
+ * A* run on a radix heap, which needs no comparisons at all, and the bidirectional search on the addressable heap.
+ * None of them accepts negative arc distances: arcs are undirected, so a negative arc is a negative cycle of length
+ * two and no shortest path exists.
+ */
+
+#include <cmath>
+#include "shortestpath.h"
+#include "pqueue.h"
+#include "searchstats.h"
+
+/*
+ * Type: queueEntryT
+ * -----------------
+ * An entry of the search priority queue.
+ */
+struct queueEntryT{
+	int node;      // node id
+	int key;       // tentative distance of the node, plus the heuristic estimate in A* mode
+};
+
+/* Function: CmpByQueueKey
+ * -----------------------
+ * This function is the callback function for comparing entries in the search queue. The entry with less key is
+ * given higher priority
+ */
+int CmpByQueueKey(queueEntryT entry1, queueEntryT entry2){
+	STATS_ADD(comparisons, 1);
+	if(entry1.key < entry2.key)  // Because less key higher priority
+		return 1;
+	else if(entry1.key == entry2.key)
+		return 0;
+	else
+		return -1;
+}
+
+/* Sizes the state for the graph and marks every node as unreached */
+void InitSearchState(searchStateT &state, int nodeCount){
+	if(state.dist.size() != nodeCount){
+		state.dist.clear();
+		state.pred.clear();
+		state.handle.clear();
+		state.target.clear();
+		for(int i = 0; i < nodeCount; i++){
+			state.dist.add(INFINITE_DISTANCE);
+			state.pred.add(NULL);
+			state.handle.add(-1);
+			state.target.add(0);
+		}
+		state.targetMark = 0;
+	}
+	else{
+		for(int i = 0; i < state.touched.size(); i++){
+			state.dist[state.touched[i]] = INFINITE_DISTANCE;
+			state.pred[state.touched[i]] = NULL;
+		}
+	}
+	state.touched.clear();
+	state.dequeues = 0;
+}
+
+void InitSearchBan(searchBanT &ban, graphT &graph){
+	if(ban.node.size() != graph.nodeList.size() || ban.arc.size() != graph.arcs.size()){
+		ban.node.clear();
+		ban.arc.clear();
+		for(int i = 0; i < graph.nodeList.size(); i++)
+			ban.node.add(0);
+		for(int i = 0; i < graph.arcs.size(); i++)
+			ban.arc.add(0);
+		ban.nodeMark = ban.arcMark = 0;
+	}
+	ban.nodeMark++;
+	ban.arcMark++;
+}
+
+/*
+ * Type: radixEntryT
+ * -----------------
+ * An element of the radix heap queue. The key is kept by the heap itself; dist is the distance of the node when it
+ * was queued, which tells a current entry from one left behind by a later improvement.
+ */
+struct radixEntryT{
+	int node;
+	int dist;
+};
+
+/*
+ * Class: RadixSearchQueue
+ * -----------------------
+ * The search queue on top of the radix heap. The radix heap cannot move an element, so an improved node is simply
+ * queued again and the outdated entry is skipped when it comes out. Needs keys that never drop below the last key
+ * dequeued, which holds for non-negative arc distances and a consistent heuristic.
+ */
+class RadixSearchQueue{
+	public:
+		RadixSearchQueue(searchStateT &state) : state(state) {}
+
+		/* Queues the node under key; an earlier entry of the node becomes outdated */
+		void push(int node, int key, bool queued){
+			radixEntryT entry = {node, state.dist[node]};
+			rh.enqueue(entry, key);
+			STATS_ADD(pushes, 1);
+			if(queued) STATS_ADD(decreaseKeys, 1);
+			STATS_MAX(maxQueueSize, rh.size());
+		}
+
+		/* Removes the node with the smallest key, skipping outdated entries. Returns false if none is left */
+		bool pop(int &node){
+			while(!rh.isEmpty()){
+				radixEntryT entry = rh.dequeueMin();
+				STATS_ADD(pops, 1);
+				if(entry.dist == state.dist[entry.node]){
+					node = entry.node;
+					return true;
+				}
+			}
+			return false;
+		}
+
+	private:
+		RadixHeap<radixEntryT> rh;
+		searchStateT &state;
+};
+
+/*
+ * Function: SettleNodes
+ * ---------------------
+ * The search loop shared by FindShortestPath, FindShortestPathsToTargets, FindShortestPathAvoiding and
+ * FindShortestPathWithin. Settles nodes from source in order of distance (plus heuristic) till target is settled,
+ * or, if targetCount is positive, till targetCount of the nodes marked with state.targetMark are settled, and never
+ * beyond maxDistance (which only makes sense without a heuristic). Nodes and arcs banned by ban, if given, are left
+ * out. Returns the number of those targets settled.
+ */
+static int SettleNodes(graphT &graph, nodeT *source, nodeT *target, int targetCount,
+                       int maxDistance, searchBanT *ban, searchStateT &state, heuristicFnT heuristic, void *clientData){
+	RadixSearchQueue queue(state);
+	state.dist[source->id] = 0;
+	state.touched.add(source->id);
+	queue.push(source->id, 0, false);
+	int reached = 0;
+	int id;
+	while(queue.pop(id)){
+		if(state.dist[id] > maxDistance) break;
+		state.dequeues++;
+		STATS_ADD(settled, 1);
+		nodeT *node = graph.nodeList[id];
+		if(node == target) return 1;
+		if(targetCount > 0 && state.target[id] == state.targetMark && ++reached == targetCount) return reached;
+		int distance = state.dist[id];
+		for(int i = 0; i < node->arcs.size(); i++){
+			arcT *arc = node->arcs[i];
+			nodeT *next = OtherEnd(arc, node);
+			if(ban != NULL && (ban->arc[arc->id] == ban->arcMark || ban->node[next->id] == ban->nodeMark)) continue;
+			STATS_ADD(relaxed, 1);
+			int newDistance = distance + arc->distance;
+			if(newDistance < state.dist[next->id]){
+				// With a consistent heuristic a settled node is never improved, so a node that was reached
+				// before is still in the queue
+				bool queued = (state.dist[next->id] != INFINITE_DISTANCE);
+				if(!queued) state.touched.add(next->id);
+				state.dist[next->id] = newDistance;
+				state.pred[next->id] = arc;
+				int key = newDistance;
+				if(heuristic != NULL)
+					key += heuristic(next, target, clientData);
+				queue.push(next->id, key, queued);
+			}
+		}
+	}
+	return reached;
+}
+
+/* Reports an error if the graph has a negative arc, on which no shortest path is defined */
+static void CheckArcDistances(graphT &graph, string function){
+	if(graph.negativeArcs > 0)
+		Error(function + ": negative arc distances are not supported");
+}
+
+/* Dijkstra's algorithm (A* if a heuristic is given) from source, stopping once target is settled */
+bool FindShortestPath(graphT &graph, nodeT *source, nodeT *target, searchStateT &state,
+                      heuristicFnT heuristic, void *clientData){
+	CheckArcDistances(graph, "FindShortestPath");
+	InitSearchState(state, graph.nodeList.size());
+	return SettleNodes(graph, source, target, 0, INFINITE_DISTANCE, NULL, state, heuristic, clientData) > 0;
+}
+
+/* Dijkstra's algorithm from source, stopping once the last of the targets is settled */
+int FindShortestPathsToTargets(graphT &graph, nodeT *source, Vector<nodeT *> &targets, searchStateT &state){
+	CheckArcDistances(graph, "FindShortestPathsToTargets");
+	InitSearchState(state, graph.nodeList.size());
+	state.targetMark++;
+	int targetCount = 0;
+	for(int i = 0; i < targets.size(); i++){
+		if(state.target[targets[i]->id] != state.targetMark) targetCount++;
+		state.target[targets[i]->id] = state.targetMark;
+	}
+	if(targetCount == 0) return 0;
+	return SettleNodes(graph, source, NULL, targetCount, INFINITE_DISTANCE, NULL, state, NULL, NULL);
+}
+
+/* Dijkstra's algorithm from source, stopping at the first node farther than maxDistance */
+int FindShortestPathWithin(graphT &graph, nodeT *source, int maxDistance, searchStateT &state){
+	CheckArcDistances(graph, "FindShortestPathWithin");
+	InitSearchState(state, graph.nodeList.size());
+	if(maxDistance < 0) return 0;
+	SettleNodes(graph, source, NULL, 0, maxDistance, NULL, state, NULL, NULL);
+	return state.dequeues;
+}
+
+/* Dijkstra's algorithm (A* if a heuristic is given) from source that skips banned nodes and arcs */
+bool FindShortestPathAvoiding(graphT &graph, nodeT *source, nodeT *target, searchStateT &state, searchBanT &ban,
+                              heuristicFnT heuristic, void *clientData){
+	CheckArcDistances(graph, "FindShortestPathAvoiding");
+	InitSearchState(state, graph.nodeList.size());
+	return SettleNodes(graph, source, target, 0, INFINITE_DISTANCE, &ban, state, heuristic, clientData) > 0;
+}
+
+/*
+ * Function: ScanSide
+ * ------------------
+ * Settles the top node of one side of a bidirectional search and relaxes its arcs. Whenever the far end of an arc
+ * has already been reached by the other side, the path through that arc is a candidate for the best path.
+ */
+static void ScanSide(graphT &graph, IndexedPQueue<queueEntryT> &pq, searchStateT &side, searchStateT &other,
+                     bool isForward, bidirectionalStateT &state){
+	queueEntryT entry = pq.dequeueMax();
+	side.dequeues++;
+	STATS_ADD(pops, 1);
+	STATS_ADD(settled, 1);
+	nodeT *node = graph.nodeList[entry.node];
+	STATS_ADD(relaxed, node->arcs.size());
+	for(int i = 0; i < node->arcs.size(); i++){
+		arcT *arc = node->arcs[i];
+		nodeT *next = OtherEnd(arc, node);
+		int newDistance = entry.key + arc->distance;
+		if(newDistance < side.dist[next->id]){
+			bool queued = (side.dist[next->id] != INFINITE_DISTANCE);
+			if(!queued) side.touched.add(next->id);
+			side.dist[next->id] = newDistance;
+			side.pred[next->id] = arc;
+			queueEntryT newEntry = {next->id, newDistance};
+			if(queued){
+				pq.increaseKey(side.handle[next->id], newEntry);
+				STATS_ADD(decreaseKeys, 1);
+			}
+			else{
+				side.handle[next->id] = pq.enqueue(newEntry);
+				STATS_ADD(pushes, 1);
+				STATS_MAX(maxQueueSize, pq.size());
+			}
+		}
+		if(other.dist[next->id] != INFINITE_DISTANCE && newDistance + other.dist[next->id] < state.distance){
+			state.distance = newDistance + other.dist[next->id];
+			state.meetingArc = arc;
+			state.forwardEnd = isForward ? node : next;
+			state.backwardEnd = isForward ? next : node;
+		}
+	}
+}
+
+/* Alternates a forward and a backward search till mu <= top_f + top_b */
+bool FindShortestPathBidirectional(graphT &graph, nodeT *source, nodeT *target, bidirectionalStateT &state){
+	CheckArcDistances(graph, "FindShortestPathBidirectional");
+	InitSearchState(state.forward, graph.nodeList.size());
+	InitSearchState(state.backward, graph.nodeList.size());
+	state.distance = INFINITE_DISTANCE;
+	state.meetingArc = NULL;
+	state.forwardEnd = state.backwardEnd = NULL;
+	state.dequeues = 0;
+	if(source == target){
+		state.distance = 0;
+		state.forwardEnd = state.backwardEnd = source;
+		return true;
+	}
+	IndexedPQueue<queueEntryT> forwardPQ(CmpByQueueKey), backwardPQ(CmpByQueueKey);
+	state.forward.dist[source->id] = 0;
+	state.backward.dist[target->id] = 0;
+	state.forward.touched.add(source->id);
+	state.backward.touched.add(target->id);
+	queueEntryT first = {source->id, 0};
+	state.forward.handle[source->id] = forwardPQ.enqueue(first);
+	queueEntryT last = {target->id, 0};
+	state.backward.handle[target->id] = backwardPQ.enqueue(last);
+	STATS_ADD(pushes, 2);
+	while(!forwardPQ.isEmpty() && !backwardPQ.isEmpty()){
+		int topForward = forwardPQ.peekMax().key;
+		int topBackward = backwardPQ.peekMax().key;
+		if(state.distance != INFINITE_DISTANCE && state.distance <= topForward + topBackward) break;
+		if(topForward <= topBackward)
+			ScanSide(graph, forwardPQ, state.forward, state.backward, true, state);
+		else
+			ScanSide(graph, backwardPQ, state.backward, state.forward, false, state);
+	}
+	state.dequeues = state.forward.dequeues + state.backward.dequeues;
+	return state.distance != INFINITE_DISTANCE;
+}
+
+/* Forward half from source, then the meeting arc, then the backward half down to target */
+Stack<arcT *> ExtractBidirectionalPath(bidirectionalStateT &state, nodeT *source, nodeT *target){
+	if(state.distance == INFINITE_DISTANCE) return Stack<arcT *>();
+	Stack<arcT *> path = ExtractPath(state.forward, source, state.forwardEnd);
+	if(state.meetingArc != NULL)
+		path.push(state.meetingArc);
+	nodeT *node = state.backwardEnd;
+	while(node != target){
+		arcT *arc = state.backward.pred[node->id];
+		path.push(arc);
+		node = OtherEnd(arc, node);
+	}
+	return path;
+}
+
+/* Returns the straight line length between two nodes on the map */
+static double MapLength(nodeT *node1, nodeT *node2){
+	double dx = node1->x - node2->x;
+	double dy = node1->y - node2->y;
+	return sqrt(dx*dx + dy*dy);
+}
+
+/* Finds the smallest ratio of arc distance to map length */
+void CalibrateHeuristic(graphT &graph){
+	double scale = -1;
+	for(int i = 0; i < graph.arcs.size(); i++){
+		arcT *arc = graph.arcs[i];
+		double length = MapLength(arc->start, arc->end);
+		if(length == 0) continue;  // end points drawn on top of each other put no bound on the ratio
+		double ratio = arc->distance / length;
+		if(scale < 0 || ratio < scale)
+			scale = ratio;
+	}
+	if(scale < 0) scale = 0;  // no usable arc, the heuristic degrades to Dijkstra's algorithm
+	graph.heuristicScale = scale*(1 - 1e-9);  // keep rounding errors from pushing an estimate over the true distance
+}
+
+/* Same ratio and margin as CalibrateHeuristic, for one arc */
+void LowerHeuristicScale(graphT &graph, arcT *arc){
+	double length = MapLength(arc->start, arc->end);
+	if(length == 0) return;
+	double scale = (arc->distance / length)*(1 - 1e-9);
+	if(scale < graph.heuristicScale)
+		graph.heuristicScale = (scale < 0) ? 0 : scale;
+}
+
+/* Scaled straight line length to target, rounded down to keep it admissible */
+int CoordinateHeuristic(nodeT *node, nodeT *target, void *clientData){
+	graphT *graph = (graphT *)clientData;
+	return (int)floor(graph->heuristicScale*MapLength(node, target));
+}
+
+/* Rebuilds the path from the predecessor arcs, arc touching target on top */
+Stack<arcT *> ExtractPath(searchStateT &state, nodeT *source, nodeT *target){
+	if(state.dist[target->id] == INFINITE_DISTANCE) return Stack<arcT *>();
+	return ExtractTreePath(state.pred, source, target);
+}
+
+/* Collects the arcs from target back to source, then pushes them starting from the source end */
+Stack<arcT *> ExtractTreePath(Vector<arcT *> &pred, nodeT *source, nodeT *target){
+	Stack<arcT *> path;
+	Vector<arcT *> reversed;  // arcs from target back to source
+	nodeT *node = target;
+	while(node != source){
+		arcT *arc = pred[node->id];
+		reversed.add(arc);
+		node = OtherEnd(arc, node);
+	}
+	for(int i = reversed.size() - 1; i >= 0; i--)
+		path.push(reversed[i]);
+	return path;
+}
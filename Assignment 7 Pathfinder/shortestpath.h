@@ -0,0 +1,206 @@
+/*
+ * File: shortestpath.h
+ * --------------------
+ * This module exports the node indexed shortest path engine. Instead of pushing whole paths through the priority
+ * queue, the engine keeps one tentative distance and one predecessor arc per node id and only turns the
+ * predecessors back into a path once the search is done. The same engine runs A* search when it is given a
+ * heuristic callback, and a bidirectional variant grows one search from each end point until they meet.
+ *
+ * The searches need non-negative arc distances and report an error on a graph with a negative arc: arcs are
+ * undirected, so a negative arc is a negative cycle of length two and there is no shortest path.
+ */
+
+#ifndef _shortestpath_h
+#define _shortestpath_h
+
+#include <climits>
+#include "genlib.h"
+#include "vector.h"
+#include "stack.h"
+#include "pathgraph.h"
+
+/* Distance of a node that has not been reached yet */
+const int INFINITE_DISTANCE = INT_MAX;
+
+/*
+ * Type: searchStateT
+ * ------------------
+ * The per query scratch state of a search, indexed by node id. A state can be reused for any number of queries on
+ * the same graph; InitSearchState resets it.
+ */
+struct searchStateT{
+	Vector<int> dist;     // best distance from the source found so far
+	Vector<arcT *> pred;  // arc on which the node was reached, NULL for the source and unreached nodes
+	Vector<int> handle;   // priority queue handle of the node while it is in the queue
+	Vector<int> touched;  // nodes whose distance the last search set, the only ones the next search has to reset
+	Vector<int> target;   // mark of the last search that had the node as a target, so marks are never cleared
+	int targetMark;       // mark of the current targets
+	int dequeues;         // number of entries removed from the priority queue by the last search
+};
+
+/*
+ * Type: searchBanT
+ * ----------------
+ * Nodes and arcs a restricted search must not use, indexed by id. An entry is banned while it equals the current
+ * mark, so a new set of bans is started by increasing the mark instead of clearing the arrays. Node and arc bans
+ * have separate marks, so either set can be replaced while the other one is kept.
+ */
+struct searchBanT{
+	Vector<int> node;  // mark of the last ban of each node id
+	Vector<int> arc;   // mark of the last ban of each arc id
+	int nodeMark;
+	int arcMark;
+};
+
+/*
+ * Type: bidirectionalStateT
+ * -------------------------
+ * The scratch state of a bidirectional search: one node indexed state per direction plus the place where the best
+ * path found so far crosses from the forward half to the backward half.
+ */
+struct bidirectionalStateT{
+	searchStateT forward;   // search grown from the source
+	searchStateT backward;  // search grown from the target
+	nodeT *forwardEnd;      // last node of the forward half of the best path
+	nodeT *backwardEnd;     // first node of the backward half of the best path
+	arcT *meetingArc;       // arc joining the two halves, NULL if they share their end node
+	int distance;           // length of the best path found, INFINITE_DISTANCE if none
+	int dequeues;           // entries removed from both priority queues by the last search
+};
+
+/*
+ * Type: heuristicFnT
+ * ------------------
+ * Callback giving a lower bound on the distance from node to target. The bound must never overestimate and must be
+ * consistent (h(u) <= distance(u, v) + h(v) for every arc), otherwise the search may return a longer path.
+ * clientData is passed through unchanged from FindShortestPath.
+ */
+typedef int (*heuristicFnT)(nodeT *node, nodeT *target, void *clientData);
+
+/*
+ * Function: InitSearchState
+ * Usage: InitSearchState(state, graph.nodeList.size());
+ * -----------------------------------------------------
+ * Sizes the state for a graph with the given number of nodes and marks every node as unreached.
+ */
+void InitSearchState(searchStateT &state, int nodeCount);
+
+/*
+ * Function: InitSearchBan
+ * Usage: InitSearchBan(ban, graph);
+ * ---------------------------------
+ * Sizes the ban arrays for the graph and starts empty sets of banned nodes and arcs.
+ */
+void InitSearchBan(searchBanT &ban, graphT &graph);
+
+/*
+ * Function: FindShortestPath
+ * Usage: if(FindShortestPath(graph, source, target, state)) ...
+ *        if(FindShortestPath(graph, source, target, state, CoordinateHeuristic, &graph)) ...
+ * ---------------------------------------------------------------------------------------
+ * Runs Dijkstra's algorithm from source and stops as soon as target is settled; with a NULL target it settles every
+ * node reachable from source. If a heuristic is given the queue is ordered by distance plus heuristic instead, which
+ * turns the search into A*. On return the state holds the distance and predecessor of every settled node. Returns
+ * false if target cannot be reached from source.
+ */
+bool FindShortestPath(graphT &graph, nodeT *source, nodeT *target, searchStateT &state,
+                      heuristicFnT heuristic = NULL, void *clientData = NULL);
+
+/*
+ * Function: FindShortestPathsToTargets
+ * Usage: int reached = FindShortestPathsToTargets(graph, source, targets, state);
+ * -------------------------------------------------------------------------------
+ * Runs Dijkstra's algorithm from source until every node in targets is settled, so one search answers the queries
+ * from source to all of them. On return the state holds the distance and predecessor of every settled node; ExtractPath
+ * gives the path to each target. Returns the number of distinct targets reached.
+ */
+int FindShortestPathsToTargets(graphT &graph, nodeT *source, Vector<nodeT *> &targets, searchStateT &state);
+
+/*
+ * Function: FindShortestPathWithin
+ * Usage: int settled = FindShortestPathWithin(graph, source, maxDistance, state);
+ * -------------------------------------------------------------------------------
+ * Runs Dijkstra's algorithm from source and stops at the first node farther than maxDistance. On return the state
+ * holds the final distance and predecessor of every node within maxDistance; those nodes are all among
+ * state.touched, together with nodes just beyond the limit whose distances are only tentative. Returns the number
+ * of nodes within maxDistance.
+ */
+int FindShortestPathWithin(graphT &graph, nodeT *source, int maxDistance, searchStateT &state);
+
+/*
+ * Function: FindShortestPathAvoiding
+ * Usage: if(FindShortestPathAvoiding(graph, source, target, state, ban)) ...
+ * --------------------------------------------------------------------------
+ * Same as FindShortestPath, except that the search never enters a banned node and never relaxes a banned arc.
+ * The source itself is used even if it is banned.
+ */
+bool FindShortestPathAvoiding(graphT &graph, nodeT *source, nodeT *target, searchStateT &state, searchBanT &ban,
+                              heuristicFnT heuristic = NULL, void *clientData = NULL);
+
+/*
+ * Function: FindShortestPathBidirectional
+ * Usage: if(FindShortestPathBidirectional(graph, source, target, state)) ...
+ * --------------------------------------------------------------------------
+ * Grows a Dijkstra search forward from source and one backward from target (arcs are bidirectional, so the backward
+ * search is an ordinary search from target), always advancing the side whose queue has the smaller top key. Every
+ * relaxed arc whose far end was reached by the other side is a candidate path of length mu; the search stops as soon
+ * as mu <= top_f + top_b, since no later candidate can be shorter. Returns false if target cannot be reached.
+ */
+bool FindShortestPathBidirectional(graphT &graph, nodeT *source, nodeT *target, bidirectionalStateT &state);
+
+/*
+ * Function: ExtractBidirectionalPath
+ * Usage: Stack<arcT *> path = ExtractBidirectionalPath(state, source, target);
+ * ----------------------------------------------------------------------------
+ * Stitches the forward and backward halves found by FindShortestPathBidirectional into one path, in the same order
+ * as ExtractPath. Returns an empty stack if target was not reached.
+ */
+Stack<arcT *> ExtractBidirectionalPath(bidirectionalStateT &state, nodeT *source, nodeT *target);
+
+/*
+ * Function: CalibrateHeuristic
+ * Usage: CalibrateHeuristic(graph);
+ * ---------------------------------
+ * Computes graph.heuristicScale, the smallest ratio of arc distance to the straight line length between the arc end
+ * points over all arcs. Scaling straight line lengths by this ratio never overestimates a path distance. Must be
+ * called again whenever the graph changes.
+ */
+void CalibrateHeuristic(graphT &graph);
+
+/*
+ * Function: LowerHeuristicScale
+ * Usage: LowerHeuristicScale(graph, arc);
+ * ---------------------------------------
+ * Lowers graph.heuristicScale as far as the ratio of arc distance to map length of one arc requires, after that
+ * arc has become shorter. Cheaper than CalibrateHeuristic when a single arc changes.
+ */
+void LowerHeuristicScale(graphT &graph, arcT *arc);
+
+/*
+ * Function: CoordinateHeuristic
+ * Usage: FindShortestPath(graph, source, target, state, CoordinateHeuristic, &graph);
+ * -----------------------------------------------------------------------------------
+ * The A* heuristic derived from the node coordinates: the straight line length to target scaled by
+ * graph.heuristicScale. clientData must point to the calibrated graphT.
+ */
+int CoordinateHeuristic(nodeT *node, nodeT *target, void *clientData);
+
+/*
+ * Function: ExtractPath
+ * Usage: Stack<arcT *> path = ExtractPath(state, source, target);
+ * ---------------------------------------------------------------
+ * Walks the predecessor arcs back from target to source and returns the arcs of the path. The arc touching target
+ * is on top of the stack, the arc leaving source at the bottom. Returns an empty stack if target was not reached.
+ */
+Stack<arcT *> ExtractPath(searchStateT &state, nodeT *source, nodeT *target);
+
+/*
+ * Function: ExtractTreePath
+ * Usage: Stack<arcT *> path = ExtractTreePath(pred, source, target);
+ * ------------------------------------------------------------------
+ * Same as ExtractPath, for a predecessor array kept apart from a search state, such as a cached shortest path tree.
+ * target must have been reached from source.
+ */
+Stack<arcT *> ExtractTreePath(Vector<arcT *> &pred, nodeT *source, nodeT *target);
+
+#endif
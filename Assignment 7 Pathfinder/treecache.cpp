@@ -0,0 +1,240 @@
+/*
+ * File: treecache.cpp
+ * -------------------
+ * This file implements the shortest path tree cache: the recency list, the eviction, the cached query and the
+ * repair of cached trees after an arc update.
+ */
+
+#include "treecache.h"
+#include "pqueue.h"
+
+/* Size charged to the budget for a tree over nodeCount nodes */
+static long long TreeBytes(int nodeCount){
+	return sizeof(cachedTreeT) + (long long)nodeCount * (sizeof(int) + sizeof(arcT *));
+}
+
+/* Takes the tree out of the recency list */
+static void Unlink(treeCacheT &cache, cachedTreeT *tree){
+	if(tree->newer != NULL) tree->newer->older = tree->older;
+	else cache.newest = tree->older;
+	if(tree->older != NULL) tree->older->newer = tree->newer;
+	else cache.oldest = tree->newer;
+	tree->newer = tree->older = NULL;
+}
+
+/* Puts the tree at the newest end of the recency list */
+static void LinkNewest(treeCacheT &cache, cachedTreeT *tree){
+	tree->older = cache.newest;
+	tree->newer = NULL;
+	if(cache.newest != NULL) cache.newest->newer = tree;
+	cache.newest = tree;
+	if(cache.oldest == NULL) cache.oldest = tree;
+}
+
+/* Drops least recently used trees till the cache is within its budget */
+static void EvictToBudget(treeCacheT &cache){
+	while(cache.usedBytes > cache.budgetBytes && cache.oldest != NULL){
+		cachedTreeT *tree = cache.oldest;
+		Unlink(cache, tree);
+		cache.bySource[tree->source] = NULL;
+		cache.usedBytes -= TreeBytes(tree->dist.size());
+		cache.evictions++;
+		delete tree;
+	}
+}
+
+treeCacheT *GetTreeCache(graphT &graph){
+	if(graph.treeCache != NULL) return graph.treeCache;
+	treeCacheT *cache = new treeCacheT;
+	cache->budgetBytes = DEFAULT_TREE_CACHE_BYTES;
+	cache->usedBytes = 0;
+	for(int i = 0; i < graph.nodeList.size(); i++)
+		cache->bySource.add(NULL);
+	cache->newest = cache->oldest = NULL;
+	cache->hits = cache->misses = cache->evictions = 0;
+	cache->repairedNodes = 0;
+	for(int i = 0; i < graph.nodeList.size(); i++)
+		cache->repairMark.add(0);
+	cache->repairStamp = 0;
+	graph.treeCache = cache;
+	return cache;
+}
+
+void SetTreeCacheBudget(graphT &graph, long long budgetBytes){
+	treeCacheT *cache = GetTreeCache(graph);
+	lock_guard<mutex> guard(cache->lock);
+	cache->budgetBytes = budgetBytes;
+	EvictToBudget(*cache);
+}
+
+/* A hit walks the cached predecessors; a miss grows the whole tree outside the lock and then caches a copy */
+bool FindShortestPathCached(graphT &graph, nodeT *source, nodeT *target, searchStateT &state,
+                            Stack<arcT *> &path, int &distance, bool &hit){
+	treeCacheT *cache = GetTreeCache(graph);
+	{
+		lock_guard<mutex> guard(cache->lock);
+		cachedTreeT *tree = cache->bySource[source->id];
+		if(tree != NULL){
+			cache->hits++;
+			Unlink(*cache, tree);
+			LinkNewest(*cache, tree);
+			hit = true;
+			distance = tree->dist[target->id];
+			if(distance == INFINITE_DISTANCE) return false;
+			path = ExtractTreePath(tree->pred, source, target);
+			return true;
+		}
+		cache->misses++;
+	}
+	hit = false;
+	FindShortestPath(graph, source, NULL, state);  // NULL target: the complete tree
+	distance = state.dist[target->id];
+	path = ExtractPath(state, source, target);
+
+	long long bytes = TreeBytes(graph.nodeList.size());
+	lock_guard<mutex> guard(cache->lock);
+	if(bytes <= cache->budgetBytes && cache->bySource[source->id] == NULL){  // another thread may have added it
+		cachedTreeT *tree = new cachedTreeT;
+		tree->source = source->id;
+		tree->dist = state.dist;
+		tree->pred = state.pred;
+		cache->bySource[source->id] = tree;
+		LinkNewest(*cache, tree);
+		cache->usedBytes += bytes;
+		EvictToBudget(*cache);
+	}
+	return distance != INFINITE_DISTANCE;
+}
+
+/*
+ * Type: repairEntryT
+ * ------------------
+ * An element of the repair queue. dist is the distance of the node when it was queued, which tells a current entry
+ * from one left behind by a later improvement.
+ */
+struct repairEntryT{
+	int node;
+	int dist;
+};
+
+/* Sets the distance of a node in the tree and queues it for Propagate */
+static void Improve(cachedTreeT &tree, int node, int distance, arcT *arc, RadixHeap<repairEntryT> &queue){
+	tree.dist[node] = distance;
+	tree.pred[node] = arc;
+	repairEntryT entry = {node, distance};
+	queue.enqueue(entry, distance);
+}
+
+/* Dijkstra's algorithm continued from the queued nodes, till no distance drops any more */
+static void Propagate(graphT &graph, treeCacheT &cache, cachedTreeT &tree, RadixHeap<repairEntryT> &queue){
+	while(!queue.isEmpty()){
+		repairEntryT entry = queue.dequeueMin();
+		if(entry.dist != tree.dist[entry.node]) continue;  // improved again after it was queued
+		cache.repairedNodes++;
+		nodeT *node = graph.nodeList[entry.node];
+		for(int i = 0; i < node->arcs.size(); i++){
+			arcT *arc = node->arcs[i];
+			int next = OtherEnd(arc, node)->id;
+			int newDistance = entry.dist + arc->distance;
+			if(newDistance < tree.dist[next])
+				Improve(tree, next, newDistance, arc, queue);
+		}
+	}
+}
+
+/* The arc got shorter: improve the end point it now reaches faster and spread from there */
+static void RepairShorterArc(graphT &graph, treeCacheT &cache, cachedTreeT &tree, arcT *arc){
+	RadixHeap<repairEntryT> queue;
+	int fromStart = tree.dist[arc->start->id];
+	int fromEnd = tree.dist[arc->end->id];
+	if(fromStart != INFINITE_DISTANCE && fromStart + arc->distance < fromEnd)
+		Improve(tree, arc->end->id, fromStart + arc->distance, arc, queue);
+	else if(fromEnd != INFINITE_DISTANCE && fromEnd + arc->distance < fromStart)
+		Improve(tree, arc->start->id, fromEnd + arc->distance, arc, queue);
+	Propagate(graph, cache, tree, queue);
+}
+
+/* The arc got longer: if the tree uses it, rebuild the subtree hanging below it */
+static void RepairLongerArc(graphT &graph, treeCacheT &cache, cachedTreeT &tree, arcT *arc){
+	nodeT *child;
+	if(tree.pred[arc->end->id] == arc) child = arc->end;
+	else if(tree.pred[arc->start->id] == arc) child = arc->start;
+	else return;  // no shortest path of the tree runs through the arc, so no distance changes
+
+	// The nodes whose tree path runs through the arc: the children of a node are the neighbours reached by it
+	int stamp = ++cache.repairStamp;
+	Vector<int> affected;
+	affected.add(child->id);
+	cache.repairMark[child->id] = stamp;
+	for(int i = 0; i < affected.size(); i++){
+		nodeT *node = graph.nodeList[affected[i]];
+		for(int j = 0; j < node->arcs.size(); j++){
+			arcT *childArc = node->arcs[j];
+			int next = OtherEnd(childArc, node)->id;
+			if(tree.pred[next] == childArc && cache.repairMark[next] != stamp){
+				cache.repairMark[next] = stamp;
+				affected.add(next);
+			}
+		}
+	}
+
+	// Each affected node starts from its best arc into the unaffected part, whose distances are still exact
+	RadixHeap<repairEntryT> queue;
+	for(int i = 0; i < affected.size(); i++){
+		int id = affected[i];
+		nodeT *node = graph.nodeList[id];
+		int best = INFINITE_DISTANCE;
+		arcT *bestArc = NULL;
+		for(int j = 0; j < node->arcs.size(); j++){
+			arcT *inArc = node->arcs[j];
+			int from = OtherEnd(inArc, node)->id;
+			if(cache.repairMark[from] == stamp || tree.dist[from] == INFINITE_DISTANCE) continue;
+			if(tree.dist[from] + inArc->distance < best){
+				best = tree.dist[from] + inArc->distance;
+				bestArc = inArc;
+			}
+		}
+		tree.dist[id] = INFINITE_DISTANCE;
+		tree.pred[id] = NULL;
+		if(bestArc != NULL)
+			Improve(tree, id, best, bestArc, queue);
+	}
+	Propagate(graph, cache, tree, queue);
+}
+
+/* Forgets every tree, for when they cannot be repaired */
+static void DropAllTrees(treeCacheT &cache){
+	while(cache.oldest != NULL){
+		cachedTreeT *tree = cache.oldest;
+		Unlink(cache, tree);
+		cache.bySource[tree->source] = NULL;
+		delete tree;
+	}
+	cache.usedBytes = 0;
+}
+
+void RepairCachedTrees(graphT &graph, arcT *arc, int oldDistance){
+	treeCacheT *cache = graph.treeCache;
+	if(cache == NULL) return;
+	lock_guard<mutex> guard(cache->lock);
+	if(graph.negativeArcs > 0){
+		DropAllTrees(*cache);
+		return;
+	}
+	for(cachedTreeT *tree = cache->newest; tree != NULL; tree = tree->older){
+		if(arc->distance < oldDistance)
+			RepairShorterArc(graph, *cache, *tree, arc);
+		else if(arc->distance > oldDistance)
+			RepairLongerArc(graph, *cache, *tree, arc);
+	}
+}
+
+void FreeTreeCache(treeCacheT *cache){
+	if(cache == NULL) return;
+	while(cache->oldest != NULL){
+		cachedTreeT *tree = cache->oldest;
+		Unlink(*cache, tree);
+		delete tree;
+	}
+	delete cache;
+}
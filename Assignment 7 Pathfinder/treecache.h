@@ -0,0 +1,104 @@
+/*
+ * File: treecache.h
+ * -----------------
+ * This module exports a cache of complete shortest path trees keyed by source node. The first query from a source
+ * runs Dijkstra's algorithm over the whole graph and keeps its distance and predecessor arrays; every later query
+ * from the same source is a walk along the predecessors. Trees are evicted least recently used first once their
+ * total size exceeds the memory budget. When an arc distance changes, the cached trees are repaired in place rather
+ * than recomputed. The cache belongs to the graph and is dropped together with it.
+ */
+
+#ifndef _treecache_h
+#define _treecache_h
+
+#include <mutex>
+#include "genlib.h"
+#include "vector.h"
+#include "stack.h"
+#include "pathgraph.h"
+#include "shortestpath.h"
+
+/* Memory budget of the cache the user interface creates, in bytes */
+const long long DEFAULT_TREE_CACHE_BYTES = 64 * 1024 * 1024;
+
+/*
+ * Type: cachedTreeT
+ * -----------------
+ * One complete shortest path tree, linked into the recency list of the cache.
+ */
+struct cachedTreeT{
+	int source;                 // node id of the root
+	Vector<int> dist;           // distance from the root to each node id, INFINITE_DISTANCE if unreachable
+	Vector<arcT *> pred;        // arc on which each node is reached from the root
+	cachedTreeT *newer, *older; // neighbours in the recency list
+};
+
+/*
+ * Type: treeCacheT
+ * ----------------
+ * The cache and its counters. All operations lock it, so queries may run on several threads.
+ */
+struct treeCacheT{
+	long long budgetBytes;            // the trees are evicted down to this total size
+	long long usedBytes;              // total size of the cached trees
+	Vector<cachedTreeT *> bySource;   // node id -> its tree, NULL if not cached
+	cachedTreeT *newest, *oldest;     // ends of the recency list
+	int hits;                         // queries answered from a cached tree
+	int misses;                       // queries that had to compute their tree
+	int evictions;                    // trees dropped to stay within the budget
+	long long repairedNodes;          // nodes whose distance arc updates had to recompute, over all trees
+	Vector<int> repairMark;           // node id -> stamp of the last repair that marked it as affected
+	int repairStamp;
+	std::mutex lock;
+};
+
+/*
+ * Function: GetTreeCache
+ * Usage: treeCacheT *cache = GetTreeCache(graph);
+ * -----------------------------------------------
+ * Returns graph.treeCache, first creating an empty cache with DEFAULT_TREE_CACHE_BYTES if there is none.
+ */
+treeCacheT *GetTreeCache(graphT &graph);
+
+/*
+ * Function: SetTreeCacheBudget
+ * Usage: SetTreeCacheBudget(graph, 256 * 1024 * 1024);
+ * ----------------------------------------------------
+ * Changes the memory budget of the graph's cache, evicting trees if it now holds too much.
+ */
+void SetTreeCacheBudget(graphT &graph, long long budgetBytes);
+
+/*
+ * Function: FindShortestPathCached
+ * Usage: if(FindShortestPathCached(graph, source, target, state, path, distance, hit)) ...
+ * ---------------------------------------------------------------------------------------
+ * Answers the query from the cached tree of source, or on a miss grows the complete tree in state, answers from it
+ * and caches a copy (unless the tree alone exceeds the budget). hit tells which happened. Returns false if target
+ * cannot be reached; otherwise path (in the order of ExtractPath) and distance describe the shortest path.
+ */
+bool FindShortestPathCached(graphT &graph, nodeT *source, nodeT *target, searchStateT &state,
+                            Stack<arcT *> &path, int &distance, bool &hit);
+
+/*
+ * Function: RepairCachedTrees
+ * Usage: RepairCachedTrees(graph, arc, oldDistance);
+ * --------------------------------------------------
+ * Brings every cached tree up to date after the distance of arc has changed from oldDistance, in the manner of
+ * Ramalingam and Reps. A shorter arc starts a Dijkstra search from the end points it improves, which stops where
+ * distances no longer drop. A longer arc only matters to a tree that uses it: the subtree below the arc is cut
+ * off, each of its nodes takes its best distance over arcs from outside the subtree, and a Dijkstra search limited
+ * to the subtree settles the rest. Either way the work depends on the nodes whose distance changes, not on the
+ * graph size. Trees cannot be repaired while the graph has negative arcs, so they are dropped then. UpdateArcDistance
+ * calls this; the graph without a cache is ignored.
+ */
+void RepairCachedTrees(graphT &graph, arcT *arc, int oldDistance);
+
+/*
+ * Function: FreeTreeCache
+ * Usage: FreeTreeCache(cache);
+ * ----------------------------
+ * Deletes the cache and all its trees. NULL is ignored.
+ */
+void FreeTreeCache(treeCacheT *cache);
+
+#endif
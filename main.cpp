@@ -19,6 +19,12 @@ int main ()
 	BasicPQueueTest();
 	MorePQueueTest();
 	PQueueSortTest();
+	IndexedPQueueTest();
+	RadixHeapTest();
+	FunctorPQueueTest();
+	DaryHeapTest();
+	BulkPQueueTest();
+	MeldableHeapTest();
    	PQueuePerformance();
     cout << endl << "Goodbye and have a nice day!" << endl;
     return (0);
@@ -16,16 +16,22 @@
 #include "random.h"
 #include "simpio.h"
 #include <ctime>
+#include <climits>
 #include <iostream>
+#include <thread>
+#include <vector>
 
 const int NumRepetitions = 1000;	// enough repetitions to register on system clock
 const int NumSortTrials = 10;  // Trials for sort
 const int MinTrialSize =  10000;
 const int MaxTrialSize = 1000000;
 
-void RunEnqueueDequeueTrial(int size);
-void RunSortTrial(int size);
-void RunMemoryTrial(int size);
+template <typename QueueType> void RunQueueTrial(int size, string comparison);
+template <typename QueueType> void RunEnqueueDequeueTrial(int size);
+template <typename QueueType> void RunSortTrial(int size);
+template <typename QueueType> void RunMemoryTrial(int size);
+void RunBuildTrial(int size);
+void RunDijkstraTrial(int size);
 double GetCurrentTime();
 void RunPerformanceTrial(int size);
 
@@ -52,19 +58,94 @@ void PQueuePerformance()
 /*
  * Function: RunPerformanceTrial
  * -----------------------------
- * Runs a time trial using pqueues of specified size.  The first 2 time trials report
+ * Times building a pqueue by enqueues and in bulk, then runs the time trials on
+ * each heap variant in turn, so that they can be compared:
+ * the binary PQueue with the classic callback, the binary PQueue with an inlined
+ * comparison, and the 4-ary and 8-ary DaryHeap with the same comparison (SIMD child
+ * selection where available) and with the callback (scalar), the pairing heap and
+ * the Fibonacci heap. Last comes a Dijkstra workload on each queue.
+ */
+
+void RunPerformanceTrial(int size)
+{
+	RunBuildTrial(size);
+	RunQueueTrial< PQueue<int> >(size, "callback");
+	RunQueueTrial< PQueue<int, MaxFirst<int> > >(size, "inlined");
+	RunQueueTrial< DaryHeap<int, MaxFirst<int>, 4> >(size, "inlined");
+	RunQueueTrial< DaryHeap<int, MaxFirst<int>, 8> >(size, "inlined");
+	RunQueueTrial< DaryHeap<int> >(size, "callback");
+	RunQueueTrial< PairingHeap<int, MaxFirst<int> > >(size, "inlined");
+	RunQueueTrial< FibonacciHeap<int, MaxFirst<int> > >(size, "inlined");
+	RunDijkstraTrial(size);
+}
+
+
+
+
+/*
+ * Function: RunBuildTrial
+ * -----------------------
+ * Times building a binary heap of the specified size from random values by one
+ * enqueue per element, by one enqueueAll and by one enqueueAll on all hardware
+ * threads. Reports results to cout.
+ */
+
+void RunBuildTrial(int size)
+{
+	Vector<int> values;
+	for (int i = 0; i < size; i++)
+		values.add(RandomInteger(1, size));
+	int numThreads = thread::hardware_concurrency();
+	if (numThreads < 1) numThreads = 1;
+	cout << endl << "---- Building a " << size << "-element pqueue -----" << endl << endl;
+
+	cout << "Time to build by " << size << " enqueues: " << flush;
+	double start = GetCurrentTime();
+	for (int j = 0; j < NumSortTrials; j++) {
+		PQueue<int> pq;
+		for (int i = 0; i < size; i++)
+			pq.enqueue(values[i]);
+	}
+	cout << (GetCurrentTime() - start)/NumSortTrials << " msecs" << endl;
+
+	cout << "Time to build by enqueueAll: " << flush;
+	start = GetCurrentTime();
+	for (int j = 0; j < NumSortTrials; j++) {
+		PQueue<int> pq;
+		pq.enqueueAll(values);
+	}
+	cout << (GetCurrentTime() - start)/NumSortTrials << " msecs" << endl;
+
+	cout << "Time to build by enqueueAll on " << numThreads << (numThreads == 1 ? " thread: " : " threads: ") << flush;
+	start = GetCurrentTime();
+	for (int j = 0; j < NumSortTrials; j++) {
+		PQueue<int> pq;
+		pq.enqueueAll(values, numThreads);
+	}
+	cout << (GetCurrentTime() - start)/NumSortTrials << " msecs" << endl;
+}
+
+
+
+
+/*
+ * Function: RunQueueTrial
+ * -----------------------
+ * Runs a time trial using pqueues of specified size and type, whose comparison is described
+ * in the heading.  The first 2 time trials report
  * the amount of time necessary to enqueue/dequeue and use pqueue to sort.
  * The last trial reports on memory usage.
  */
 
-void RunPerformanceTrial(int size)
+template <typename QueueType>
+void RunQueueTrial(int size, string comparison)
 {
 	
-	PQueue<int> pq;
-	cout << endl << "---- Performance for " << size << "-element pqueue (" << pq.implementationName() << ")" << " -----" << endl << endl;
-	RunEnqueueDequeueTrial(size);
-	RunSortTrial(size);
-    RunMemoryTrial(size);
+	QueueType pq;
+	cout << endl << "---- Performance for " << size << "-element pqueue (" << pq.implementationName() << ", " << comparison << " comparison)" << " -----" << endl << endl;
+	RunEnqueueDequeueTrial<QueueType>(size);
+	RunSortTrial<QueueType>(size);
+    RunMemoryTrial<QueueType>(size);
     cout << endl << "------------------- End of trial ---------------------" << endl << endl;
 }
 
@@ -82,9 +163,10 @@ void RunPerformanceTrial(int size)
  * a loop and time that.
  */
 
+template <typename QueueType>
 void RunEnqueueDequeueTrial(int size)
 {
-	PQueue<int> pq;
+	QueueType pq;
 	
 	for (int i = 0; i < size; i++)
 		pq.enqueue(RandomInteger(1,size));
@@ -105,6 +187,25 @@ void RunEnqueueDequeueTrial(int size)
 
 
 
+/*
+ * Function: QueueSort
+ * -------------------
+ * PQSort with a pqueue of the given type.
+ */
+
+template <typename QueueType>
+void QueueSort(int array[], int nElems)
+{
+	QueueType pq;
+	for (int i = 0; i < nElems; i++)
+		pq.enqueue(array[i]);
+	for (int i = nElems-1; i >= 0; i--)
+		array[i] = pq.dequeueMax();
+}
+
+
+
+
 /*
  * Function: RunSortTrial
  * ----------------------
@@ -112,6 +213,7 @@ void RunEnqueueDequeueTrial(int size)
  * Reports results to cout.
  */
 
+template <typename QueueType>
 void RunSortTrial(int size)
 {
 	int *array = new int[size];
@@ -121,7 +223,7 @@ void RunSortTrial(int size)
     cout << "Time to pqsort random sequence of " << size << " elements: " << flush;
 	double start = GetCurrentTime();
 	for (int j = 0; j < NumSortTrials; j++)
-		PQSort(array, size);
+		QueueSort<QueueType>(array, size);
     cout << (GetCurrentTime() - start)/ NumSortTrials << " msecs" << endl;
 	
     cout << "Time to pqsort sorted sequence of " << size << " elements: " << flush;
@@ -129,7 +231,7 @@ void RunSortTrial(int size)
 		array[j] = j;
 	start = GetCurrentTime();
 	for (int j = 0; j < NumSortTrials; j++)
-		PQSort(array, size);
+		QueueSort<QueueType>(array, size);
     cout << (GetCurrentTime() - start)/ NumSortTrials << " msecs" << endl;
 	
     cout << "Time to pqsort reverse-sorted sequence of " << size << " elements: " << flush;
@@ -137,12 +239,15 @@ void RunSortTrial(int size)
 		array[k] = size - k;
 	start = GetCurrentTime();
 	for (int j = 0; j < NumSortTrials; j++)
-		PQSort(array, size);
+		QueueSort<QueueType>(array, size);
     cout << (GetCurrentTime() - start)/NumSortTrials << " msecs" << endl;
 
 	delete [] array;
 }
 
+
+
+
 /*
  * Function: RunMemoryTrial
  * ------------------------
@@ -151,9 +256,10 @@ void RunSortTrial(int size)
  * on the memory usage again. Reports results to cout.
  */
 
+template <typename QueueType>
 void RunMemoryTrial(int size)
 {
-    PQueue<int> pq;
+    QueueType pq;
     cout << endl << "Running memory trial on " << size << "-element pqueue" << endl;
     for (int i = 0; i < size; i++)
 		pq.enqueue(RandomInteger(1, size));
@@ -172,6 +278,196 @@ void RunMemoryTrial(int size)
     cout << "After more enqueue/dequeue, " << num << "-element pqueue is using "
          << pq.bytesUsed()/1000 << " KB of memory" << endl;
 }
+
+
+
+
+/*
+ * Type: workloadGraphT
+ * --------------------
+ * The graph of the Dijkstra trial, as arrays: the arcs leaving node i are the
+ * indices firstArc[i] .. firstArc[i+1]-1 of target and length.
+ */
+
+struct workloadGraphT {
+	vector<int> firstArc;
+	vector<int> target;
+	vector<int> length;
+};
+
+/* An entry of the Dijkstra queues: a node and its tentative distance */
+struct dijkstraEntryT {
+	int distance;
+	int node;
+};
+
+/* Callback for the Dijkstra queues: the shorter distance has the higher priority */
+int CmpDijkstraEntries(dijkstraEntryT one, dijkstraEntryT two)
+{
+	if (one.distance == two.distance) return 0;
+	return (one.distance < two.distance) ? 1 : -1;
+}
+
+
+
+
+/*
+ * Function: MakeWorkloadGraph
+ * ---------------------------
+ * Builds a connected graph of size nodes, a ring plus two random edges per node,
+ * every edge a pair of arcs of the same random length from 1 to 1000.
+ */
+
+void MakeWorkloadGraph(int size, workloadGraphT &graph)
+{
+	vector<int> from, to, length;
+	for (int i = 0; i < size; i++) {
+		for (int j = 0; j < 3; j++) {
+			int other = (j == 0) ? (i + 1) % size : RandomInteger(0, size - 1);
+			int distance = RandomInteger(1, 1000);
+			from.push_back(i);
+			to.push_back(other);
+			length.push_back(distance);
+			from.push_back(other);
+			to.push_back(i);
+			length.push_back(distance);
+		}
+	}
+	graph.firstArc.assign(size + 1, 0);
+	for (size_t k = 0; k < from.size(); k++)
+		graph.firstArc[from[k] + 1]++;
+	for (int i = 0; i < size; i++)
+		graph.firstArc[i + 1] += graph.firstArc[i];
+	graph.target.resize(from.size());
+	graph.length.resize(from.size());
+	vector<int> next(graph.firstArc.begin(), graph.firstArc.end() - 1);
+	for (size_t k = 0; k < from.size(); k++) {
+		int slot = next[from[k]]++;
+		graph.target[slot] = to[k];
+		graph.length[slot] = length[k];
+	}
+}
+
+
+
+
+/*
+ * Function: ReportDijkstra
+ * ------------------------
+ * Prints the time of one Dijkstra run and checks its distances against those of the
+ * first run, which expected holds (or is set to if it is still empty).
+ */
+
+void ReportDijkstra(string strategy, double msecs, vector<int> &dist, vector<int> &expected)
+{
+	if (expected.empty()) expected = dist;
+	if (dist != expected) Error("RunDijkstraTrial: " + strategy + " found different distances");
+	cout << "Time for Dijkstra with " << strategy << ": " << msecs << " msecs" << endl;
+}
+
+
+
+
+/*
+ * Function: RunDijkstraWithIncreaseKey
+ * ------------------------------------
+ * Runs Dijkstra from node 0 with an addressable queue: every node is enqueued once,
+ * and a shorter distance found later raises it in the queue by its handle.
+ */
+
+template <typename QueueType>
+void RunDijkstraWithIncreaseKey(workloadGraphT &graph, vector<int> &expected)
+{
+	int nodeCount = graph.firstArc.size() - 1;
+	vector<int> dist(nodeCount, INT_MAX), handle(nodeCount, -1);
+	vector<bool> settled(nodeCount, false);
+	double start = GetCurrentTime();
+	QueueType pq(CmpDijkstraEntries);
+	dijkstraEntryT entry = {0, 0};
+	dist[0] = 0;
+	handle[0] = pq.enqueue(entry);
+	while (!pq.isEmpty()) {
+		dijkstraEntryT nearest = pq.dequeueMax();
+		settled[nearest.node] = true;
+		for (int k = graph.firstArc[nearest.node]; k < graph.firstArc[nearest.node + 1]; k++) {
+			int next = graph.target[k];
+			int distance = nearest.distance + graph.length[k];
+			if (settled[next] || distance >= dist[next]) continue;
+			dist[next] = distance;
+			entry.distance = distance;
+			entry.node = next;
+			if (handle[next] == -1)
+				handle[next] = pq.enqueue(entry);
+			else
+				pq.increaseKey(handle[next], entry);
+		}
+	}
+	ReportDijkstra(pq.implementationName() + " and increaseKey", GetCurrentTime() - start, dist, expected);
+}
+
+
+
+
+/*
+ * Function: RunLazyDijkstra
+ * -------------------------
+ * Runs Dijkstra from node 0 with a queue that cannot raise an element: a node is
+ * enqueued again for every shorter distance found, and dequeued entries that are
+ * no longer the node's distance are skipped.
+ */
+
+template <typename QueueType>
+void RunLazyDijkstra(workloadGraphT &graph, vector<int> &expected)
+{
+	int nodeCount = graph.firstArc.size() - 1;
+	vector<int> dist(nodeCount, INT_MAX);
+	double start = GetCurrentTime();
+	QueueType pq(CmpDijkstraEntries);
+	dijkstraEntryT entry = {0, 0};
+	dist[0] = 0;
+	pq.enqueue(entry);
+	while (!pq.isEmpty()) {
+		dijkstraEntryT nearest = pq.dequeueMax();
+		if (nearest.distance > dist[nearest.node]) continue;	// outdated entry
+		for (int k = graph.firstArc[nearest.node]; k < graph.firstArc[nearest.node + 1]; k++) {
+			int next = graph.target[k];
+			int distance = nearest.distance + graph.length[k];
+			if (distance >= dist[next]) continue;
+			dist[next] = distance;
+			entry.distance = distance;
+			entry.node = next;
+			pq.enqueue(entry);
+		}
+	}
+	ReportDijkstra(pq.implementationName() + " and repeated enqueues", GetCurrentTime() - start, dist, expected);
+}
+
+
+
+
+/*
+ * Function: RunDijkstraTrial
+ * --------------------------
+ * Times Dijkstra's algorithm over a random graph of the specified size with the
+ * addressable queues, raising queued nodes by increaseKey, and with the binary and
+ * 4-ary heaps, enqueueing nodes again instead. Reports results to cout.
+ */
+
+void RunDijkstraTrial(int size)
+{
+	workloadGraphT graph;
+	MakeWorkloadGraph(size, graph);
+	cout << endl << "---- Dijkstra on a " << size << "-node graph with " << graph.target.size() << " arcs -----"
+	     << endl << endl;
+	vector<int> expected;
+	RunDijkstraWithIncreaseKey< IndexedPQueue<dijkstraEntryT> >(graph, expected);
+	RunDijkstraWithIncreaseKey< PairingHeap<dijkstraEntryT> >(graph, expected);
+	RunDijkstraWithIncreaseKey< FibonacciHeap<dijkstraEntryT> >(graph, expected);
+	RunLazyDijkstra< PQueue<dijkstraEntryT> >(graph, expected);
+	RunLazyDijkstra< DaryHeap<dijkstraEntryT, FunctionCmp<dijkstraEntryT>, 4> >(graph, expected);
+	cout << endl << "------------------- End of trial ---------------------" << endl << endl;
+}
+
 double GetCurrentTime()
 {
       return (clock()*1000.0/CLOCKS_PER_SEC);
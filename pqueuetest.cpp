@@ -12,7 +12,11 @@
 #include "pqueuetest.h"
 #include "simpio.h"
 #include "random.h"
+#include <algorithm>
+#include <climits>
 #include <iostream>
+#include <memory>
+#include <string>
 
 bool ArrayIsSorted(int array[], int size);
 
@@ -138,6 +142,478 @@ void PQueueSortTest()
 	GetLine();
 }
 
+/*
+ * Function: IndexedPQueueTest
+ * Usage: IndexedPQueueTest();
+ * ---------------------------
+ * Tests the handle based operations of IndexedPQueue: increaseKey, decreaseKey, contains
+ * and remove. Then does a long run of random operations and checks every dequeued element
+ * against a plain list of the expected contents. Reports results of test to cout.
+ */
+void IndexedPQueueTest()
+{
+	IndexedPQueue<int> pq;
+	int handles[11];
+	
+	cout << boolalpha;
+	cout << endl << "-----------   Testing IndexedPQueue functions -----------" << endl;
+	cout << "Enqueuing integers from 1 to 10 and remembering their handles" << endl;
+	for (int i = 1; i <= 10; i++)
+		handles[i] = pq.enqueue(i);
+	cout << "Raising 3 to 20, lowering 9 to 0 and removing 5" << endl;
+	pq.increaseKey(handles[3], 20);
+	pq.decreaseKey(handles[9], 0);
+	pq.remove(handles[5]);
+	cout << "Pqueue should have size = 9.  What is size? " << pq.size() << endl;
+	cout << "Handle of 5 was removed.  Is it contained? " << pq.contains(handles[5]) << endl;
+	cout << "Element under the handle of 9 should be 0.  What is it? " << pq.getElement(handles[9]) << endl;
+	cout << "Dequeuing should give 20 10 8 7 6 4 2 1 0: ";
+	while (!pq.isEmpty())
+		cout << pq.dequeueMax() << " ";
+	cout << endl;
+
+	cout << "Running random enqueue/dequeue/increaseKey/decreaseKey/remove operations." << endl;
+	Vector<int> live;		// handles of the elements currently in pq
+	Vector<int> values;		// value of each of those elements
+	bool matches = true;
+	for (int j = 0; j < 5000; j++) {
+		int op = RandomInteger(0, 4);
+		if (op == 0 || live.isEmpty()) {
+			values.add(RandomInteger(1, 1000));
+			live.add(pq.enqueue(values[values.size() - 1]));
+		} else if (op == 1) {
+			int max = pq.dequeueMax();
+			for (int k = 0; k < live.size(); k++) {
+				if (values[k] > max) matches = false;		// something larger was left behind
+				if (!pq.contains(live[k])) {		// this is the handle that was just dequeued
+					if (values[k] != max) matches = false;
+					live.removeAt(k);
+					values.removeAt(k);
+					k--;
+				}
+			}
+		} else {
+			int index = RandomInteger(0, live.size() - 1);
+			if (op == 2) {
+				values[index] += RandomInteger(0, 100);
+				pq.increaseKey(live[index], values[index]);
+			} else if (op == 3) {
+				values[index] -= RandomInteger(0, 100);
+				pq.decreaseKey(live[index], values[index]);
+			} else {
+				pq.remove(live[index]);
+				if (pq.contains(live[index])) matches = false;
+				live.removeAt(index);
+				values.removeAt(index);
+			}
+		}
+		if (pq.size() != live.size()) matches = false;
+	}
+	cout << "Did every operation match the expected contents? " << matches << endl;
+
+	cout << endl << "Hit return to continue: ";
+	GetLine();
+}
+
+/*
+ * Function: RadixHeapTest
+ * Usage: RadixHeapTest();
+ * -----------------------
+ * Tests the monotone RadixHeap: basic enqueue/dequeueMin order, keys equal to the last
+ * key dequeued, and a long run that interleaves enqueues of keys at or above the last
+ * key with dequeues, checking every dequeued key against a sorted reference. Reports
+ * results of test to cout.
+ */
+void RadixHeapTest()
+{
+	RadixHeap<int> rh;
+	
+	cout << boolalpha;
+	cout << endl << "-----------   Testing RadixHeap functions -----------" << endl;
+	cout << "Enqueuing keys 7 3 9 3 0 1000000000, each as its own element" << endl;
+	int keys[] = {7, 3, 9, 3, 0, 1000000000};
+	for (int i = 0; i < 6; i++)
+		rh.enqueue(keys[i], keys[i]);
+	cout << "Smallest key should be 0.  What is it? " << rh.peekMinKey() << endl;
+	cout << "Dequeuing three should give 0 3 3: ";
+	for (int i = 0; i < 3; i++)
+		cout << rh.dequeueMin() << " ";
+	cout << endl;
+	cout << "Enqueuing 3 again (equal to the last key) and 4" << endl;
+	rh.enqueue(3, 3);
+	rh.enqueue(4, 4);
+	cout << "Dequeuing all should give 3 4 7 9 1000000000: ";
+	while (!rh.isEmpty())
+		cout << rh.dequeueMin() << " ";
+	cout << endl;
+	cout << "Pqueue should be empty.  Is it empty? " << rh.isEmpty() << endl;
+
+	cout << "Running random monotone enqueue/dequeueMin operations." << endl;
+	Vector<int> pending;		// keys in rh, kept sorted
+	bool matches = true;
+	for (int j = 0; j < 5000; j++) {
+		if (RandomInteger(0, 2) != 0 || pending.isEmpty()) {
+			int key = rh.lastKey() + RandomInteger(0, 1000);
+			rh.enqueue(key, key);
+			int k = 0;
+			while (k < pending.size() && pending[k] < key) k++;
+			pending.insertAt(k, key);
+		} else {
+			int key = rh.dequeueMin();
+			if (key != pending[0]) matches = false;
+			pending.removeAt(0);
+		}
+		if (rh.size() != pending.size()) matches = false;
+	}
+	cout << "Did every dequeued key match the expected key? " << matches << endl;
+	cout << endl << "Hit return to continue: ";
+	GetLine();
+}
+
+/* Functor that gives the smaller integer the higher priority */
+struct SmallerFirst {
+	int operator()(const int &one, const int &two) const {
+		return (one < two) ? 1 : ((two < one) ? -1 : 0);
+	}
+};
+
+/* Callback of the classic form that gives the smaller integer the higher priority */
+int SmallerFirstCallback(int one, int two)
+{
+	return (one < two) ? 1 : ((two < one) ? -1 : 0);
+}
+
+/* An element that counts how often it is copied */
+struct CopyCounter {
+	int value;
+	static int copies;
+	CopyCounter(int value) : value(value) {}
+	CopyCounter(const CopyCounter &other) : value(other.value) { copies++; }
+	CopyCounter(CopyCounter &&other) noexcept : value(other.value) {}
+	CopyCounter &operator=(const CopyCounter &other) { value = other.value; copies++; return *this; }
+	CopyCounter &operator=(CopyCounter &&other) noexcept { value = other.value; return *this; }
+};
+int CopyCounter::copies = 0;
+
+/*
+ * Function: FunctorPQueueTest
+ * Usage: FunctorPQueueTest();
+ * ---------------------------
+ * Tests the PQueue with a functor, a lambda and a callback as comparison, with
+ * move-only elements through enqueue of a temporary, emplace and dequeueMax, and
+ * checks that a long run of moves copies no element. Reports results of test to cout.
+ */
+void FunctorPQueueTest()
+{
+	cout << boolalpha;
+	cout << endl << "-----------   Testing PQueue comparison functors and moves -----------" << endl;
+	PQueue<int, SmallerFirst> functorPQ;
+	PQueue<int> callbackPQ(SmallerFirstCallback);
+	cout << "Enqueuing 5 9 1 7 3 with a functor and with a callback that rank smaller first" << endl;
+	int values[] = {5, 9, 1, 7, 3};
+	for (int i = 0; i < 5; i++) {
+		functorPQ.enqueue(values[i]);
+		callbackPQ.enqueue(values[i]);
+	}
+	cout << "Dequeuing should give 1 3 5 7 9 twice: ";
+	while (!functorPQ.isEmpty())
+		cout << functorPQ.dequeueMax() << " ";
+	while (!callbackPQ.isEmpty())
+		cout << callbackPQ.dequeueMax() << " ";
+	cout << endl;
+
+	auto longerFirst = [](const string &one, const string &two) { return one.size() > two.size(); };
+	PQueue<string, decltype(longerFirst)> lambdaPQ(longerFirst);
+	cout << "Enqueuing \"ab\" \"abcd\" \"a\" \"ccc\" with a lambda that ranks longer first" << endl;
+	lambdaPQ.enqueue("ab");
+	lambdaPQ.enqueue("abcd");
+	lambdaPQ.emplace("a");
+	lambdaPQ.emplace(3, 'c');
+	cout << "Dequeuing should give abcd ccc ab a: ";
+	while (!lambdaPQ.isEmpty())
+		cout << lambdaPQ.dequeueMax() << " ";
+	cout << endl;
+
+	auto largerPointee = [](const unique_ptr<int> &one, const unique_ptr<int> &two) { return *one > *two; };
+	PQueue<unique_ptr<int>, decltype(largerPointee)> movePQ(largerPointee);
+	cout << "Enqueuing unique_ptr to 1 .. 10, half moved in and half emplaced" << endl;
+	for (int i = 1; i <= 10; i++) {
+		if (i % 2 == 0)
+			movePQ.enqueue(unique_ptr<int>(new int(i)));
+		else
+			movePQ.emplace(new int(i));
+	}
+	cout << "Dequeuing should give 10 down to 1: ";
+	while (!movePQ.isEmpty())
+		cout << *movePQ.dequeueMax() << " ";
+	cout << endl;
+
+	auto smallerValue = [](const CopyCounter &one, const CopyCounter &two) { return one.value < two.value; };
+	PQueue<CopyCounter, decltype(smallerValue)> countPQ(smallerValue);
+	cout << "Running random enqueue/emplace/dequeueMax operations on elements that count their copies." << endl;
+	CopyCounter::copies = 0;
+	int last = -1;
+	bool sorted = true;
+	for (int j = 0; j < 5000; j++) {
+		if (RandomInteger(0, 2) != 0 || countPQ.isEmpty()) {
+			int value = last + RandomInteger(1, 1000);
+			if (RandomInteger(0, 1) == 0)
+				countPQ.enqueue(CopyCounter(value));
+			else
+				countPQ.emplace(value);
+		} else {
+			CopyCounter smallest = countPQ.dequeueMax();
+			if (smallest.value < last) sorted = false;
+			last = smallest.value;
+		}
+	}
+	cout << "Did every element come out in order? " << sorted << endl;
+	cout << "Elements should never be copied.  How many copies? " << CopyCounter::copies << endl;
+	cout << endl << "Hit return to continue: ";
+	GetLine();
+}
+
+/*
+ * Function: MatchesBinaryHeap
+ * ---------------------------
+ * Runs random enqueue/dequeueMax operations on pq and on a binary PQueue with the same
+ * comparison, with many equal values and the extreme ints, and returns true if every
+ * dequeued element and every size matched.
+ */
+template <typename QueueType, typename CompareType>
+bool MatchesBinaryHeap(QueueType &pq, CompareType comparator)
+{
+	PQueue<int, CompareType> reference(comparator);
+	bool matches = true;
+	for (int j = 0; j < 20000; j++) {
+		if (RandomInteger(0, 2) != 0 || reference.isEmpty()) {
+			int value = RandomInteger(-50, 50);
+			if (RandomChance(.02)) value = RandomChance(.5) ? INT_MIN : INT_MAX;
+			pq.enqueue(value);
+			reference.enqueue(value);
+		} else if (pq.dequeueMax() != reference.dequeueMax()) {
+			matches = false;
+		}
+		if (pq.size() != reference.size()) matches = false;
+	}
+	while (!reference.isEmpty())
+		if (pq.dequeueMax() != reference.dequeueMax()) matches = false;
+	return matches && pq.isEmpty();
+}
+
+/*
+ * Function: DaryHeapTest
+ * Usage: DaryHeapTest();
+ * ----------------------
+ * Tests the DaryHeap with four and eight children, on int keys with the SIMD child
+ * selection and with a callback, against the binary PQueue, and with move-only elements.
+ * Reports results of test to cout.
+ */
+void DaryHeapTest()
+{
+	cout << boolalpha;
+	cout << endl << "-----------   Testing DaryHeap functions -----------" << endl;
+	DaryHeap<int, MaxFirst<int>, 4> largest4;
+	DaryHeap<int, MinFirst<int>, 4> smallest4;
+	DaryHeap<int, MaxFirst<int>, 8> largest8;
+	DaryHeap<int, MinFirst<int>, 8> smallest8;
+	DaryHeap<int, FunctionCmp<int>, 4> callback4;
+	DaryHeap<int, FunctionCmp<int>, 8> callback8(SmallerFirstCallback);
+	cout << "Enqueuing integers from 1 to 20 into a " << largest4.implementationName() << endl;
+	for (int i = 1; i <= 20; i++)
+		largest4.enqueue(i);
+	cout << "Dequeuing should give 20 down to 1: ";
+	while (!largest4.isEmpty())
+		cout << largest4.dequeueMax() << " ";
+	cout << endl;
+
+	cout << "Running random operations against a binary heap with the same order." << endl;
+	cout << largest4.implementationName() << ", larger first.  Did they match? "
+	     << MatchesBinaryHeap(largest4, MaxFirst<int>()) << endl;
+	cout << smallest4.implementationName() << ", smaller first.  Did they match? "
+	     << MatchesBinaryHeap(smallest4, MinFirst<int>()) << endl;
+	cout << largest8.implementationName() << ", larger first.  Did they match? "
+	     << MatchesBinaryHeap(largest8, MaxFirst<int>()) << endl;
+	cout << smallest8.implementationName() << ", smaller first.  Did they match? "
+	     << MatchesBinaryHeap(smallest8, MinFirst<int>()) << endl;
+	cout << callback4.implementationName() << ", OperatorCmp.  Did they match? "
+	     << MatchesBinaryHeap(callback4, FunctionCmp<int>()) << endl;
+	cout << callback8.implementationName() << ", smaller first callback.  Did they match? "
+	     << MatchesBinaryHeap(callback8, FunctionCmp<int>(SmallerFirstCallback)) << endl;
+
+	auto largerPointee = [](const unique_ptr<int> &one, const unique_ptr<int> &two) { return *one > *two; };
+	DaryHeap<unique_ptr<int>, decltype(largerPointee), 8> movePQ(largerPointee);
+	cout << "Enqueuing unique_ptr to 1 .. 30 into a " << movePQ.implementationName() << endl;
+	for (int i = 1; i <= 30; i++)
+		movePQ.emplace(new int(i));
+	cout << "Dequeuing should give 30 down to 1: ";
+	while (!movePQ.isEmpty())
+		cout << *movePQ.dequeueMax() << " ";
+	cout << endl;
+	cout << endl << "Hit return to continue: ";
+	GetLine();
+}
+
+/*
+ * Function: DrainsInOrder
+ * -----------------------
+ * Dequeues everything from pq and returns true if it came out as the expected
+ * values from largest to smallest.
+ */
+bool DrainsInOrder(PQueue<int> &pq, vector<int> expected)
+{
+	sort(expected.begin(), expected.end());
+	bool matches = (pq.size() == (int)expected.size());
+	for (int i = (int)expected.size() - 1; i >= 0 && !pq.isEmpty(); i--)
+		if (pq.dequeueMax() != expected[i]) matches = false;
+	return matches && pq.isEmpty();
+}
+
+/*
+ * Function: BulkPQueueTest
+ * Usage: BulkPQueueTest();
+ * ------------------------
+ * Tests building a PQueue from a Vector and from an iterator range, enqueueAll of a
+ * few and of many elements into a queue that is not empty, and a parallel build of a
+ * large queue. Reports results of test to cout.
+ */
+void BulkPQueueTest()
+{
+	cout << boolalpha;
+	cout << endl << "-----------   Testing PQueue bulk construction -----------" << endl;
+	Vector<int> values;
+	for (int i = 1; i <= 10; i++)
+		values.add(i);
+	PQueue<int> vectorPQ(values);
+	cout << "Built a pqueue from a Vector of 1 to 10.  Dequeuing should give 10 down to 1: ";
+	while (!vectorPQ.isEmpty())
+		cout << vectorPQ.dequeueMax() << " ";
+	cout << endl;
+	int array[] = {5, 9, 1, 7, 3};
+	PQueue<int> rangePQ(array, array + 5, SmallerFirstCallback);
+	cout << "Built a pqueue from 5 9 1 7 3 with smaller first.  Dequeuing should give 1 3 5 7 9: ";
+	while (!rangePQ.isEmpty())
+		cout << rangePQ.dequeueMax() << " ";
+	cout << endl;
+
+	vector<int> expected;
+	PQueue<int> pq;
+	for (int i = 0; i < 1000; i++) {
+		expected.push_back(RandomInteger(1, 100));
+		pq.enqueue(expected.back());
+	}
+	vector<int> few, many;
+	for (int i = 0; i < 5; i++)
+		few.push_back(RandomInteger(1, 100));
+	for (int i = 0; i < 5000; i++)
+		many.push_back(RandomInteger(1, 100));
+	pq.enqueueAll(few.begin(), few.end());
+	pq.enqueueAll(many.begin(), many.end());
+	expected.insert(expected.end(), few.begin(), few.end());
+	expected.insert(expected.end(), many.begin(), many.end());
+	cout << "Enqueued 5 and then 5000 more values into a 1000-element pqueue with enqueueAll." << endl;
+	cout << "Do all of them come out in order? " << DrainsInOrder(pq, expected) << endl;
+
+	vector<int> large;
+	for (int i = 0; i < 2000000; i++)
+		large.push_back(RandomInteger(1, 1000000));
+	PQueue<int> parallelPQ(large.begin(), large.end(), FunctionCmp<int>(), 4);
+	cout << "Built a 2000000-element pqueue on 4 threads.  Do all elements come out in order? "
+	     << DrainsInOrder(parallelPQ, large) << endl;
+	cout << endl << "Hit return to continue: ";
+	GetLine();
+}
+
+/*
+ * Function: MatchesIndexedPQueue
+ * ------------------------------
+ * Runs random enqueue, increaseKey and dequeueMax operations on pq and on an
+ * IndexedPQueue, and returns true if every dequeued element, every size and every
+ * handle matched. The last four digits of each value are a serial number, which keeps
+ * the values unique, so both queues dequeue the same element every time.
+ */
+template <typename QueueType>
+bool MatchesIndexedPQueue(QueueType &pq)
+{
+	IndexedPQueue<int> reference;
+	vector<int> handles, referenceHandles;	// handles of the same elements in both queues
+	bool matches = true;
+	for (int serial = 0; serial < 3000; serial++) {
+		int choice = RandomInteger(0, 3);
+		if (choice <= 1 || reference.isEmpty()) {
+			int value = RandomInteger(0, 999) * 10000 + serial;
+			handles.push_back(pq.enqueue(value));
+			referenceHandles.push_back(reference.enqueue(value));
+		} else if (choice == 2) {
+			int k = RandomInteger(0, handles.size() - 1);
+			int value = pq.getElement(handles[k]) + RandomInteger(1, 50) * 10000;
+			pq.increaseKey(handles[k], value);
+			reference.increaseKey(referenceHandles[k], value);
+		} else {
+			if (pq.dequeueMax() != reference.dequeueMax()) matches = false;
+			for (int k = 0; k < (int)handles.size(); k++) {
+				if (pq.contains(handles[k])) continue;
+				if (reference.contains(referenceHandles[k])) matches = false;
+				handles[k] = handles.back();
+				handles.pop_back();
+				referenceHandles[k] = referenceHandles.back();
+				referenceHandles.pop_back();
+				break;
+			}
+		}
+		if (pq.size() != reference.size()) matches = false;
+	}
+	while (!reference.isEmpty())
+		if (pq.dequeueMax() != reference.dequeueMax()) matches = false;
+	return matches && pq.isEmpty();
+}
+
+/*
+ * Function: MeldableHeapTest
+ * Usage: MeldableHeapTest();
+ * --------------------------
+ * Tests the PairingHeap and the FibonacciHeap: enqueue/dequeueMax order, increaseKey,
+ * and a long run of random operations against an IndexedPQueue. Reports results of
+ * test to cout.
+ */
+void MeldableHeapTest()
+{
+	cout << boolalpha;
+	cout << endl << "-----------   Testing PairingHeap and FibonacciHeap functions -----------" << endl;
+	PairingHeap<int> pairing;
+	FibonacciHeap<int, MaxFirst<int> > fibonacci;
+	cout << "Enqueuing integers from 1 to 10 into each" << endl;
+	for (int i = 1; i <= 10; i++) {
+		pairing.enqueue(i);
+		fibonacci.enqueue(i);
+	}
+	cout << "Dequeuing 5 from each should give 10 9 8 7 6 twice: ";
+	for (int i = 0; i < 5; i++)
+		cout << pairing.dequeueMax() << " ";
+	for (int i = 0; i < 5; i++)
+		cout << fibonacci.dequeueMax() << " ";
+	cout << endl;
+	int pairingHandle = pairing.enqueue(3);
+	int fibonacciHandle = fibonacci.enqueue(3);
+	pairing.increaseKey(pairingHandle, 100);
+	fibonacci.increaseKey(fibonacciHandle, 100);
+	cout << "Enqueued 3 and raised it to 100.  Dequeuing all should give 100 5 4 3 2 1 twice: ";
+	while (!pairing.isEmpty())
+		cout << pairing.dequeueMax() << " ";
+	while (!fibonacci.isEmpty())
+		cout << fibonacci.dequeueMax() << " ";
+	cout << endl;
+
+	cout << "Running random enqueue/increaseKey/dequeueMax operations against an indexed heap." << endl;
+	PairingHeap<int> randomPairing;
+	FibonacciHeap<int> randomFibonacci;
+	cout << randomPairing.implementationName() << ".  Did they match? " << MatchesIndexedPQueue(randomPairing) << endl;
+	cout << randomFibonacci.implementationName() << ".  Did they match? " << MatchesIndexedPQueue(randomFibonacci)
+	     << endl;
+	cout << endl << "Hit return to continue: ";
+	GetLine();
+}
+
 /*
  * Function: PQSort
  * Usage: PQSort(arr, n);
@@ -152,9 +628,7 @@ void PQueueSortTest()
 
 void PQSort(int array[], int nElems)
 {
-	PQueue<int> pq;
-	for (int i = 0; i < nElems; i++)	
-		pq.enqueue(array[i]);
+	PQueue<int> pq(array, array + nElems);	// built bottom-up in one linear pass
 	for (int i = nElems-1; i >= 0; i--)
 		array[i] = pq.dequeueMax();
 }
@@ -43,6 +43,71 @@ void MorePQueueTest();
  */
 void PQueueSortTest();
 
+/*
+ * Function: IndexedPQueueTest
+ * Usage: IndexedPQueueTest();
+ * ---------------------------
+ * Tests the handle based operations of IndexedPQueue: increaseKey, decreaseKey, contains
+ * and remove. Then does a long run of random operations and checks every dequeued element
+ * against a plain list of the expected contents. Reports results of test to cout.
+ */
+void IndexedPQueueTest();
+
+/*
+ * Function: RadixHeapTest
+ * Usage: RadixHeapTest();
+ * -----------------------
+ * Tests the monotone RadixHeap: basic enqueue/dequeueMin order, keys equal to the last
+ * key dequeued, and a long run that interleaves enqueues of keys at or above the last
+ * key with dequeues, checking every dequeued key against a sorted reference. Reports
+ * results of test to cout.
+ */
+void RadixHeapTest();
+
+
+/*
+ * Function: FunctorPQueueTest
+ * Usage: FunctorPQueueTest();
+ * ---------------------------
+ * Tests the PQueue with a functor, a lambda and a callback as comparison, with
+ * move-only elements through enqueue of a temporary, emplace and dequeueMax, and
+ * checks that a long run of moves copies no element. Reports results of test to cout.
+ */
+void FunctorPQueueTest();
+
+
+/*
+ * Function: DaryHeapTest
+ * Usage: DaryHeapTest();
+ * ----------------------
+ * Tests the DaryHeap with four and eight children, on int keys with the SIMD child
+ * selection and with a callback, against the binary PQueue, and with move-only elements.
+ * Reports results of test to cout.
+ */
+void DaryHeapTest();
+
+
+/*
+ * Function: BulkPQueueTest
+ * Usage: BulkPQueueTest();
+ * ------------------------
+ * Tests building a PQueue from a Vector and from an iterator range, enqueueAll of a
+ * few and of many elements into a queue that is not empty, and a parallel build of a
+ * large queue. Reports results of test to cout.
+ */
+void BulkPQueueTest();
+
+
+/*
+ * Function: MeldableHeapTest
+ * Usage: MeldableHeapTest();
+ * --------------------------
+ * Tests the PairingHeap and the FibonacciHeap: enqueue/dequeueMax order, increaseKey,
+ * and a long run of random operations against an IndexedPQueue. Reports results of
+ * test to cout.
+ */
+void MeldableHeapTest();
+
 
 /*
  * Function: PQSort